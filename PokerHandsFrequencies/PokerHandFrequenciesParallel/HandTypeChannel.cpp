@@ -0,0 +1,132 @@
+/*
+* Program: PokerHandFrequenciesParallel
+* Module: HandTypeChannel.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Tells the master which hand types the slaves have found. See HandTypeChannel.h.
+*/
+
+#include "HandTypeChannel.h"
+
+//Const
+const int TAG_DATA = 1;
+
+//Constructor
+HandTypeChannel::HandTypeChannel(){
+	for (int slot = 0; slot < SEND_SLOTS; ++slot)
+		_sendRequests[slot] = MPI_REQUEST_NULL;
+	for (int slot = 0; slot < RECEIVE_SLOTS; ++slot)
+		_receiveRequests[slot] = MPI_REQUEST_NULL;
+	_sent = 0;
+	_received = 0;
+}
+
+//Deconstructor
+HandTypeChannel::~HandTypeChannel(){
+}
+
+/*
+* Purpose: Send the master a mask of hand types. Uses a buffer whose send has finished, waiting
+*		   for one to finish if every buffer is still in flight.
+* Parameters: unsigned mask of hand types, one bit per HandType
+* Returns: None
+*/
+void HandTypeChannel::send(unsigned types) {
+	int freeSlot = -1;
+	for (int slot = 0; slot < SEND_SLOTS && freeSlot < 0; ++slot) {
+		if (_sendRequests[slot] != MPI_REQUEST_NULL) {
+			// A finished request is freed and set to MPI_REQUEST_NULL by the test
+			int done;
+			MPI_Test(&_sendRequests[slot], &done, MPI_STATUS_IGNORE);
+		}
+		if (_sendRequests[slot] == MPI_REQUEST_NULL)
+			freeSlot = slot;
+	}
+	if (freeSlot < 0)
+		MPI_Waitany(SEND_SLOTS, _sendRequests, &freeSlot, MPI_STATUS_IGNORE);
+
+	_sendBuffers[freeSlot] = types;
+	MPI_Isend(&_sendBuffers[freeSlot], 1, MPI_UNSIGNED, 0, TAG_DATA, MPI_COMM_WORLD, &_sendRequests[freeSlot]);
+	++_sent;
+}
+
+/*
+* Purpose: Wait for every send to finish. The master must be receiving them, see finishReceiving().
+* Parameters: None
+* Returns: None
+*/
+void HandTypeChannel::finishSends() {
+	MPI_Waitall(SEND_SLOTS, _sendRequests, MPI_STATUSES_IGNORE);
+}
+
+/*
+* Purpose: Get the number of messages sent
+* Parameters: None
+* Returns: Int
+*/
+int HandTypeChannel::sent() const {
+	return _sent;
+}
+
+/*
+* Purpose: Post a receive for a message from any slave into a receive buffer
+* Parameters: Int buffer slot
+* Returns: None
+*/
+void HandTypeChannel::_postReceive(int slot) {
+	MPI_Irecv(&_receiveBuffers[slot], 1, MPI_UNSIGNED, MPI_ANY_SOURCE, TAG_DATA, MPI_COMM_WORLD, &_receiveRequests[slot]);
+}
+
+/*
+* Purpose: Post all of the receives, before the master starts dealing
+* Parameters: None
+* Returns: None
+*/
+void HandTypeChannel::startReceiving() {
+	for (int slot = 0; slot < RECEIVE_SLOTS; ++slot)
+		_postReceive(slot);
+}
+
+/*
+* Purpose: Check, without waiting, for messages from the slaves. Each buffer that received one
+*		   is posted again straight away.
+* Parameters: None
+* Returns: unsigned - the hand types in the messages received, 0 if there were none
+*/
+unsigned HandTypeChannel::poll() {
+	int indices[RECEIVE_SLOTS];
+	int numDone;
+	MPI_Testsome(RECEIVE_SLOTS, _receiveRequests, &numDone, indices, MPI_STATUSES_IGNORE);
+
+	unsigned types = 0;
+	for (int i = 0; i < numDone; ++i) {
+		types |= _receiveBuffers[indices[i]];
+		_postReceive(indices[i]);
+	}
+	if (numDone > 0)
+		_received += numDone;
+	return types;
+}
+
+/*
+* Purpose: Receive the messages still in flight once the slaves have stopped, then cancel the
+*		   receives left posted
+* Parameters: Int number of messages sent by all of the slaves
+* Returns: None
+*/
+void HandTypeChannel::finishReceiving(int totalSent) {
+	while (_received < totalSent) {
+		int slot;
+		MPI_Waitany(RECEIVE_SLOTS, _receiveRequests, &slot, MPI_STATUS_IGNORE);
+		++_received;
+		_postReceive(slot);
+	}
+
+	// Every message has been received, so nothing can match these any more
+	for (int slot = 0; slot < RECEIVE_SLOTS; ++slot) {
+		if (_receiveRequests[slot] != MPI_REQUEST_NULL) {
+			MPI_Cancel(&_receiveRequests[slot]);
+			MPI_Wait(&_receiveRequests[slot], MPI_STATUS_IGNORE);
+		}
+	}
+}
@@ -0,0 +1,50 @@
+#if !defined(__HANDTYPECHANNEL_H__)
+#define __HANDTYPECHANNEL_H__
+/*
+* Program: PokerHandFrequenciesParallel
+* Module: HandTypeChannel.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Tells the master which hand types the slaves have found. A message is the
+*      mask of the hand types a slave found since its last message (one bit per HandType),
+*      so a slave sends at most ten. Slaves send from a small pool of buffers and every
+*      send is completed before the buffer is used again; the master keeps a fixed set of
+*      receives posted so messages from many slaves land without waiting for a receive.
+*      Every message sent is received before the program ends, none are left in flight.
+*/
+
+#include <mpi.h>
+
+class HandTypeChannel {
+public:
+
+	//Constructor/Deconstructor
+	HandTypeChannel();
+	~HandTypeChannel();
+
+	//Public Methods - slave
+	void send(unsigned types);
+	void finishSends();
+	int sent() const;
+
+	//Public Methods - master
+	void startReceiving();
+	unsigned poll();
+	void finishReceiving(int totalSent);
+
+private:
+	void _postReceive(int slot);
+
+	//Const
+	static const int SEND_SLOTS = 4;
+	static const int RECEIVE_SLOTS = 16;
+
+	//Member Variables
+	unsigned _sendBuffers[SEND_SLOTS];
+	MPI_Request _sendRequests[SEND_SLOTS];
+	unsigned _receiveBuffers[RECEIVE_SLOTS];
+	MPI_Request _receiveRequests[RECEIVE_SLOTS];
+	int _sent;
+	int _received;
+};
+#endif
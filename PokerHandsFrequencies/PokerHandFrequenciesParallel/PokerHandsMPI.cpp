@@ -9,37 +9,57 @@
 *      Simulation results are then output to the console.
 */
 
-#include <cstdlib> // srand(), rand()
 #include <string>
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
-#include <map>
-#include <ctime>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "HandTypeChannel.h"
 #include "PokerHandsMPI.h"
+#include "../PokerHandsCore/EquityCalculator.h"
+#include "../PokerHandsCore/HandEnumerator.h"
+#include "../PokerHandsCore/HandStatistics.h"
+#include "../PokerHandsCore/ReportFormatter.h"
 #include <mpi.h>
 
 using namespace std;
 
-//Globals
-bool PokerHandsMPI::_seeded = false;
 //Const
-const int TAG_DATA = 1, TAG_QUIT = 2, TAG_RESULTS = 3;
-const int MAX_MSG_SIZE = 16;
+// Tags of a --hands run's messages: a slave's counts and request for a chunk, and the master's chunk
+const int TAG_CHUNK_REQUEST = 2;
+const int TAG_CHUNK = 3;
+// Hands the master's other threads take from the scheduler at a time
+const uint64_t MASTER_BLOCK_HANDS = 16 * HandBatch::SIZE;
 
 //Constructor
-PokerHandsMPI::PokerHandsMPI(){
-	setUpDeck();
-	frequencyMap["     Full House"] = 0;
-	frequencyMap["       Two Pair"] = 0;
-	frequencyMap[" Four of a Kind"] = 0;
-	frequencyMap["Three of a Kind"] = 0;
-	frequencyMap["       One Pair"] = 0;
-	frequencyMap["    Royal Flush"] = 0;
-	frequencyMap[" Straight Flush"] = 0;
-	frequencyMap["       Straight"] = 0;
-	frequencyMap["          Flush"] = 0;
-	frequencyMap["        No Pair"] = 0;
+PokerHandsMPI::PokerHandsMPI(const SimulationOptions& options, int rank, int numProcs, const Checkpoint& resumed) : pool(options, rank), rule(options), sampler(options, rank), checkpoint(resumed), pollInterval(options.pollMicroseconds * 1e-6){
+	stopReason = STOP_NONE;
+	numHands = options.hands;
+	reproducible = options.reproducible;
+	chunksSent = 0;
+	tailTime = 0;
+	lastRank = 0;
+	multinomial = false;
+	tablesLoadTime = 0;
+	fromTable = false;
+	checkpoint.begin(options, numProcs);
+	checkpointFile = options.checkpointFile;
+	checkpointSeconds = options.checkpointSeconds;
+	checkpoints = 0;
+	checkpointTime = 0;
+	snapshotSeconds = options.snapshotSeconds;
+	seed = options.seed;
+	generator = options.generator;
+	exhaustive = options.exhaustive;
+	cardsPerHand = options.cardsPerHand;
+	reportDelay = 0;
+	polls = 0;
+	pollSeconds = 0;
+	pollHands = 0;
+	quitLatency = 0;
 }
 
 //Destructor
@@ -47,702 +67,862 @@ PokerHandsMPI::~PokerHandsMPI(){
 }
 
 /*
-* Purpose: Add 52 cards as integers to the deck
+* Purpose:Report total number of poker hands generated and absolute and relative frequencies for each of the ten hand-types
 * Parameters: None
 * Returns: None
 */
-void PokerHandsMPI::setUpDeck() {
-	for (int i = 1; i <= 52; ++i)
-	{
-		deck[i - 1] = i;
+void PokerHandsMPI::report(int numProcs){
+	// The final snapshot is written before the report, so the two never mix on the console
+	if (results.isOpen()) {
+		int numThreads = pool.size();
+		vector<uint64_t> rankHands(numProcs, 0);
+		for (int rank = 0; rank < numProcs; ++rank)
+			for (int thread = 0; thread < numThreads; ++thread)
+				rankHands[rank] += threadHands[rank * numThreads + thread];
+		results.publish(counts, checkpoint.previousElapsed + duration, rankHands, true);
+		results.close();
 	}
-}
 
-/*
-* Purpose: Swap random elements from randomizeDeck()
-* Parameters: Int pointer to ls, rs
-* Returns: None
-*/
-void swap(int *a, int *b) {
-	int temp = *a;
-	*a = *b;
-	*b = temp;
+	//Print out Hand Type and Frequency and relative frequency
+	string version = (numProcs == 1) ? "Serial Version" : "Parallel Version";
+	if (cardsPerHand == 7)
+		version += ", 7 Cards";
+	if (exhaustive)
+		version += ", Exhaustive";
+	if (multinomial)
+		version += ", Multinomial";
+	ReportFormatter::printHeader(cout, version.c_str());
+	ReportFormatter::printCounts(cout, counts);
+
+	ReportFormatter::printRule(cout);
+	cout << fixed << setprecision(3);
+	ReportFormatter::printField(cout, "Hands Generated", counts.total());
+	ReportFormatter::printField(cout, "Elapsed Time (s)", duration);
+	ReportFormatter::printField(cout, "# of Processes", numProcs);
+	ReportFormatter::printField(cout, "# of Threads", pool.size());
+	ReportFormatter::printField(cout, "Seed", seed);
+	ReportFormatter::printField(cout, "Generator", RandomStream::typeName(generator));
+	ReportFormatter::printField(cout, "Cards per Hand", cardsPerHand);
+	ReportFormatter::printField(cout, "Classifier", (cardsPerHand == 7) ? "7-card masks" : BatchClassifier::levelName(pool.worker(0).classifierLevel()));
+	ReportFormatter::printField(cout, "Engine", multinomial ? "multinomial" : fromTable ? "table" : reproducible ? "dealt by hand index" : "dealt hands");
+	if (tables.isOpen())
+		ReportFormatter::printField(cout, "Table Load (us)", 1e6 * tablesLoadTime);
+	if (checkpoint.segment > 0) {
+		ReportFormatter::printField(cout, "Segment", checkpoint.segment);
+		ReportFormatter::printField(cout, "Resumed Hands", checkpoint.previous.total());
+		ReportFormatter::printField(cout, "Resumed Time (s)", checkpoint.previousElapsed);
+	}
+	if (checkpoints > 0) {
+		ReportFormatter::printField(cout, "Checkpoints", checkpoints);
+		ReportFormatter::printField(cout, "Checkpoint (ms)", 1e3 * checkpointTime);
+		ReportFormatter::printField(cout, "Checkpoint (%)", 100.0 * checkpointTime / duration);
+	}
+	if (rule.isChecked()) {
+		ReportFormatter::printField(cout, "Stopped By", StoppingRule::reasonName(stopReason));
+		cout << setprecision(6);
+		ReportFormatter::printField(cout, "Worst +/- (%)", 100.0 * HandStatistics::worstRelativeHalfWidth(counts));
+		cout << setprecision(3);
+	}
+	_printThroughput(numProcs);
+	if (rule.isChecked()) {
+		ReportFormatter::printRule(cout);
+		ReportFormatter::printIntervals(cout, counts);
+	}
+	// Where the threads' time went, when built with PHF_PHASE_TIMING
+	if (PhaseTimer::enabled() && !multinomial && !fromTable) {
+		double threadSeconds = 0;
+		for (int rank = 0; rank < numProcs; ++rank)
+			threadSeconds += rankTimes[rank] * pool.size();
+		ReportFormatter::printRule(cout);
+		ReportFormatter::printPhases(cout, phases, counts.total() - checkpoint.previous.total(), threadSeconds);
+	}
 }
 
 /*
-* Purpose: Sort the hand of 5 cards to determine its suit and rank
-* Parameters: const int pointer to ls, rs
-* Returns:
+* Purpose: Collect on the master how many hands every thread of every process dealt, how long each
+*		   process ran and the host it ran on, for the throughput in the report. Every process calls it.
+* Parameters: numProcs - the number of processes
 */
-bool sort_cards(const int& a, const int& b) {
-	return a % 13 < b % 13;
+void PokerHandsMPI::gatherThroughput(int numProcs) {
+	int numThreads = pool.size();
+	vector<uint64_t> hands(numThreads);
+	for (int thread = 0; thread < numThreads; ++thread)
+		hands[thread] = pool.worker(thread).counts().total();
+
+	char host[MPI_MAX_PROCESSOR_NAME] = { 0 };
+	int hostLength;
+	MPI_Get_processor_name(host, &hostLength);
+
+	threadHands.resize(numProcs * numThreads);
+	rankTimes.resize(numProcs);
+	hostNames.resize(numProcs * MPI_MAX_PROCESSOR_NAME);
+	MPI_Gather(hands.data(), numThreads, MPI_UINT64_T, threadHands.data(), numThreads, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+	MPI_Gather(&duration, 1, MPI_DOUBLE, rankTimes.data(), 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+	MPI_Gather(host, MPI_MAX_PROCESSOR_NAME, MPI_CHAR, hostNames.data(), MPI_MAX_PROCESSOR_NAME, MPI_CHAR, 0, MPI_COMM_WORLD);
+
+	if (PhaseTimer::enabled()) {
+		PhaseTimes local = pool.phases();
+		local.add(mpiPhases);
+		MPI_Reduce(local.cycles, phases.cycles, NUM_PHASES, MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+	}
+
+	// Only slaves check for the quit, the sums are 0 in every other mode
+	double pollLocal[3] = { (double)polls, pollSeconds, (double)pollHands }, pollTotal[3] = { 0 };
+	double latency = quitLatency;
+	MPI_Reduce(pollLocal, pollTotal, 3, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+	MPI_Reduce(&latency, &quitLatency, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+	polls = (uint64_t)pollTotal[0];
+	pollSeconds = pollTotal[1];
+	pollHands = (uint64_t)pollTotal[2];
 }
 
 /*
-* Purpose: Randomizes the deck of integers
-* Parameters: Int array, Int, Int
-* Returns: None
+* Purpose: Print the hands per second of each host (node), and of its slowest and fastest thread.
+*		   Processes that dealt no hands are left out, and so is the table when the counts were drawn.
+* Parameters: numProcs - the number of processes
 */
-void PokerHandsMPI::randomizeDeck(int arr[], int n, int rank) {
+void PokerHandsMPI::_printThroughput(int numProcs) {
+	int numThreads = pool.size();
+	// Only the hands of this segment were dealt in its time
+	ReportFormatter::printField(cout, "Hands / sec", (uint64_t)((counts.total() - checkpoint.previous.total()) / duration));
+	if (reportDelay > 0)
+		ReportFormatter::printField(cout, "Report Delay (ms)", reportDelay * 1000);
+	if (polls > 0) {
+		ReportFormatter::printField(cout, "Poll Target (us)", 1e6 * pollInterval.targetSeconds());
+		ReportFormatter::printField(cout, "Hands / Poll", pollHands / polls);
+		ReportFormatter::printField(cout, "Quit Latency (us)", 1e6 * quitLatency);
+		ReportFormatter::printField(cout, "Poll (ns / hand)", 1e9 * pollSeconds / pollHands);
+	}
+	if (numHands > 0 && numProcs > 1) {
+		ReportFormatter::printField(cout, "Chunks", chunksSent);
+		ReportFormatter::printField(cout, "Tail (ms)", 1e3 * tailTime);
+		ReportFormatter::printField(cout, "Last Rank", lastRank);
+	}
+	// No thread dealt the drawn counts, any hands they dealt were to validate them
+	if (multinomial)
+		return;
+	ReportFormatter::printRule(cout);
+	cout << setw(22) << "Host" << setw(7) << "Ranks" << setw(9) << "Threads" << setw(14) << "Hands / sec"
+		<< setw(14) << "Thread Min" << setw(14) << "Thread Max" << '\n';
+
+	// Hosts in the order they first appear
+	vector<string> hosts;
+	vector<int> ranksOnHost;
+	vector<double> hostRate, minRate, maxRate;
+	for (int rank = 0; rank < numProcs; ++rank) {
+		double time = rankTimes[rank];
+		uint64_t rankHands = 0;
+		for (int thread = 0; thread < numThreads; ++thread)
+			rankHands += threadHands[rank * numThreads + thread];
+		if (rankHands == 0 || time <= 0)
+			continue;
+
+		string host(&hostNames[rank * MPI_MAX_PROCESSOR_NAME]);
+		size_t h = find(hosts.begin(), hosts.end(), host) - hosts.begin();
+		if (h == hosts.size()) {
+			hosts.push_back(host);
+			ranksOnHost.push_back(0);
+			hostRate.push_back(0);
+			minRate.push_back(-1);
+			maxRate.push_back(0);
+		}
 
-	//Start from the last element and swap one by one.
-	for (int i = n - 1; i >= 0; i--)
-	{
-		//pick a random index from 0 - i
-		int j = getRandom(rank);
+		++ranksOnHost[h];
+		hostRate[h] += rankHands / time;
+		for (int thread = 0; thread < numThreads; ++thread) {
+			double rate = threadHands[rank * numThreads + thread] / time;
+			if (minRate[h] < 0 || rate < minRate[h])
+				minRate[h] = rate;
+			maxRate[h] = max(maxRate[h], rate);
+		}
+	}
 
-		//Swap deck[i] with the element at random index
-		swap(&deck[i], &arr[j]);
+	cout << fixed << setprecision(0);
+	for (size_t h = 0; h < hosts.size(); ++h) {
+		cout << setw(22) << hosts[h].substr(0, 20) << setw(7) << ranksOnHost[h] << setw(9) << ranksOnHost[h] * numThreads
+			<< setw(14) << hostRate[h] << setw(14) << minRate[h] << setw(14) << maxRate[h] << '\n';
 	}
 }
 
 /*
-* Purpose:Report total number of poker hands generated and absolute and relative frequencies for each of the ten hand-types
+* Purpose: Deal hands on every thread of the pool when there is one process. Each HandWorker deals
+*		   batches from its own deck and stream, classifies them and adds them to its own counts. All of
+*		   them stop once one of every hand type has been found by any of them.
 * Parameters: None
 * Returns: None
 */
-void PokerHandsMPI::report(int numProcs){
-	//Get the total hands generated
-	unsigned int handsGenerated = 0;
-	for (std::map<string, int>::iterator it = frequencyMap.begin(); it != frequencyMap.end(); ++it)
-	{
-		handsGenerated += it->second;
-	}
-	//Print out Hand Type and Frequency and relative frequency
-	if (numProcs == 1)
-		cout << "            Poker Hand Frequency Simulation [Serial Version]\n";
-	else
-		cout << "            Poker Hand Frequency Simulation [Parallel Version]\n";
-	cout << "================================================================================\n";
-	cout << "        Hand Type                Frequency       Relative Frequency (%)         \n";
-	cout << "--------------------------------------------------------------------------------\n";
+void PokerHandsMPI::processSerial() {
+	double startTime = MPI_Wtime();
+	// Every thread deals until one of every hand type has been found by any of them
+	atomic<unsigned> typesSeen(0);
+	pool.run([&typesSeen](HandWorker& worker, int) { worker.drawUntilAllFound(typesSeen); });
+	counts = pool.counts();
+	duration = MPI_Wtime() - startTime;
+}
 
-	//Print out Hand Type and Frequency and relative frequency
-	for (std::map<string, int>::iterator it = frequencyMap.begin(); it != frequencyMap.end(); ++it)
+/*
+* Purpose: sum the hand-type counts of every process on the master, together with the number of
+*		   hand type messages the slaves sent, in one reduce
+* Parameters: sent - the number of hand type messages this process sent
+* Returns: uint64_t - on the master, the number of messages sent by all of the slaves
+*/
+uint64_t PokerHandsMPI::reduceResults(uint64_t sent) {
+	uint64_t local[NUM_HAND_TYPES + 1], total[NUM_HAND_TYPES + 1] = { 0 };
+	copy(pool.counts().count.begin(), pool.counts().count.end(), local);
+	local[NUM_HAND_TYPES] = sent;
+
+	MPI_Reduce(local, total, NUM_HAND_TYPES + 1, MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+	copy(total, total + NUM_HAND_TYPES, counts.count.begin());
+	return total[NUM_HAND_TYPES];
+}
+
+/*
+* Purpose: perform the function of the master process, simulating card hands and processing results from the slaves.
+*		   The master deals hands like a slave and only checks for messages after each batch of hands it deals.
+*		   Once every hand type is found it joins the barrier the slaves are waiting on, which tells all of
+*		   them to stop, and the counts of every process are summed with one reduce.
+* Parameters: numProcs- the of processes, if greater then one then there are slaves to manage
+*/
+void PokerHandsMPI::processMaster(int numProcs) {
+	if (numProcs == 1)
 	{
-		cout << fixed << setprecision(6);
-		cout << "  " << it->first;
-		printNumber(it->second);
-		//Calculate relative frequency
-		double value = 100.0 * (it->second) / handsGenerated;
-		if (value < 10.0)
-			cout << " ";
-		cout << "                    " << value << '\n';
+		processSerial();
 	}
+	else {
+		// Start the timer
+		double startTime = MPI_Wtime();
 
-	cout << fixed << setprecision(3);
-	cout << "--------------------------------------------------------------------------------\n";
-	cout << "  Hands Generated: " << handsGenerated << endl;  //Hands Generated is the total frequency
-	cout << " Elapsed Time (s): " << duration << endl;
-	cout << "   # of Processes: " << numProcs << endl;
+		// The master's other threads only deal hands, like the threads of a slave
+		atomic<unsigned> typesSeen(0);
+		atomic<bool> stop(false);
+		pool.start([&typesSeen, &stop](HandWorker& worker, int) { worker.drawUntilStopped(typesSeen, stop); });
+
+		// Deal hands and get new hand types from slaves, exit when we get them all.
+		// Hand types the master's own threads found count like ones sent in by a slave.
+		HandTypeChannel channel;
+		channel.startReceiving();
+		unsigned found = 0;
+		while (found != ALL_TYPES_SEEN) {
+			pool.worker(0).drawBatch(typesSeen);
+			PHASE_START(mark);
+			found |= typesSeen.load() | channel.poll();
+			PHASE_STOP(mpiPhases, PHASE_MPI_WAIT, mark);
+		}
+		double allFoundTime = MPI_Wtime();
+
+		// Joining the barrier completes it, so every slave stops
+		MPI_Request quitRequest;
+		MPI_Ibarrier(MPI_COMM_WORLD, &quitRequest);
+		stop = true;
+		pool.join();
+		MPI_Wait(&quitRequest, MPI_STATUS_IGNORE);
+
+		uint64_t totalSent = reduceResults(0);
+		duration = MPI_Wtime() - startTime;
+		reportDelay = MPI_Wtime() - allFoundTime;
+
+		// Take in the messages still in flight so the slaves' sends can finish
+		channel.finishReceiving((int)totalSent);
+	}
 }
 
 /*
-* Purpose: Creates a seed if it hasn't already been seeded and gets a random number
-* Parameters: void
-* Returns: A random int between 0 and 51
+* Purpose: perform the function of a slave process, simulating card hands and processing results.
+*		   The main thread deals a block of batches with no MPI call in it, then checks for the quit
+*		   and sends any new hand types. Blocks are sized from the measured rate to take about
+*		   --poll-us, which bounds how long the slave deals after the master's quit.
+* Parameters: None
 */
-int PokerHandsMPI::getRandom(int rank)
-{
-	if (!_seeded)
-		_seedRNG(rank);
+void PokerHandsMPI::processSlave() {
+	double startTime = MPI_Wtime();
+
+	HandTypeChannel channel;
+	int isActive = 1;
+
+	// Every slave joins the barrier now, it completes once the master joins it after every hand type is found
+	MPI_Request quitRequest;
+	MPI_Ibarrier(MPI_COMM_WORLD, &quitRequest);
+
+	// The other threads only deal hands; this thread also deals and is the only one that talks to MPI.
+	// Hand types found by any thread of this process are reported to the master once.
+	atomic<unsigned> typesSeen(0);
+	atomic<bool> stop(false);
+	unsigned reported = 0;
+	pool.start([&typesSeen, &stop](HandWorker& worker, int) { worker.drawUntilStopped(typesSeen, stop); });
+
+	double lastPoll = MPI_Wtime();
+	while (isActive) {
+
+		// Draw hands, tell the master if you get a new hand type
+		// This thread's HandWorker deals a block of batches, classifying each hand and counting its type
+		int block = pollInterval.batches();
+		for (int b = 0; b < block; ++b)
+			pool.worker(0).drawBatch(typesSeen);
+
+		// check if the master has joined the barrier
+		PHASE_START(mark);
+		double pollStart = MPI_Wtime();
+		int quit;
+		MPI_Test(&quitRequest, &quit, MPI_STATUS_IGNORE);
+		isActive = !quit;
+
+		// if no exit, let the master know of any new hand types
+		if (isActive) {
+			unsigned found = typesSeen.load() & ~reported;
+			if (found) {
+				channel.send(found);
+				reported |= found;
+			}
+		}
+		double pollEnd = MPI_Wtime();
+		PHASE_STOP(mpiPhases, PHASE_MPI_WAIT, mark);
+
+		// The quit was seen at most one block after the barrier completed
+		++polls;
+		pollSeconds += pollEnd - pollStart;
+		quitLatency = pollEnd - lastPoll;
+		pollInterval.update(block, pollEnd - lastPoll);
+		lastPoll = pollEnd;
+	}
+	pollHands = pool.worker(0).counts().total();
+
+	stop = true;
+	pool.join();
+	counts = pool.counts();
+	duration = MPI_Wtime() - startTime;
+
+	// add the results to the master's then quit/finalize once the master has every message
+	reduceResults(channel.sent());
+	channel.finishSends();
 
-	return rand() % 52;
 }
 
 /*
-* Purpose: Checks if seeded flag needs to be seeded
-* Parameters: void
-* Returns: None
+* Purpose: deal exactly numHands hands (--hands) between the processes. The master hands out guided
+*		   chunks of them as the slaves ask (see ChunkScheduler.h), so faster processes deal more, while
+*		   its own threads deal small blocks of what is left. Each request carries the counts of the
+*		   slave's chunk before, which the master adds to the counts as they come in.
+* Parameters: rank - the rank of this process, numProcs - the number of processes
 */
-void PokerHandsMPI::_seedRNG(int rank)
-{
-	// Seed the random number generator
-	srand((int)(time(0) / rank));
-
-	_seeded = true;
+void PokerHandsMPI::processHands(int rank, int numProcs) {
+	double startTime = MPI_Wtime();
+	if (rank == 0)
+		_serveChunks(numProcs);
+	else
+		_fetchChunks();
+	duration = MPI_Wtime() - startTime;
 }
 
 /*
-* Purpose: Simulates drawing a poker hand by referencing the first 5 cards in the deck data structure.
-*		   Analyzes the hand to identify which hand-type the had represents and increments the corresponding
-*		   element in the frequencies data structure. End the loop when one of every hand type has been found.
-* Parameters: None
-* Returns: None
+* Purpose: the master's part of a --hands run. The other threads take blocks until none are left;
+*		   this thread deals blocks sized to take about --poll-us and serves the requests that came in
+*		   between them, then only serves requests until every slave has sent its last counts. The time
+*		   each process finished is taken on the master's clock: the last block of the master's
+*		   threads, or the arrival of a slave's last counts.
+* Parameters: numProcs - the number of processes
 */
-void PokerHandsMPI::processSerial() {
-	int handTypeCount = 0;
-	bool isFlush, isRoyal;
-	do {
-		//Start the clock
-		start = clock();
-		bool isPair = false, isTriple = false, isTwoPair = false, isFullHouse = false, isQuadruple = false;
-		isRoyal = false;
-		bool isStraight = true;
-		isFlush = true;
-		//Randomize the deck of cards
-		randomizeDeck(deck, 52);
-		for (int i = 0; i < 5; ++i) {
-			hand[i] = deck[i];
-			// Check the suits for flushness while the hand is populated
-			if (hand[0] / 13 != hand[i] / 13) {
-				isFlush = false;
-			}
+void PokerHandsMPI::_serveChunks(int numProcs) {
+	int numThreads = pool.size();
+	ChunkScheduler scheduler(numHands, numProcs * numThreads);
+	Stopwatch timer;
+	vector<double> finished(numProcs, 0), threadFinished(numThreads, 0);
+	int slavesLeft = numProcs - 1;
+
+	// One receive is posted at a time, for a request from any slave; each slave has its own reply
+	uint64_t message[NUM_HAND_TYPES + 1];
+	vector<uint64_t> replies(2 * numProcs, 0);
+	vector<MPI_Request> replyRequests(numProcs, MPI_REQUEST_NULL);
+	MPI_Request request = MPI_REQUEST_NULL;
+	if (slavesLeft > 0)
+		MPI_Irecv(message, NUM_HAND_TYPES + 1, MPI_UINT64_T, MPI_ANY_SOURCE, TAG_CHUNK_REQUEST, MPI_COMM_WORLD, &request);
+
+	pool.run([&](HandWorker& worker, int thread) {
+		uint64_t begin, end;
+		if (thread > 0) {
+			while (scheduler.takeBlock(MASTER_BLOCK_HANDS, begin, end))
+				worker.drawRange(begin, end);
+			threadFinished[thread] = timer.elapsed();
+			return;
 		}
-		// Sort the hand array with STL sort.
-		sort(hand, hand + 5, sort_cards);
-		// If not flush, then we can have pairs, triples, quadruples, fullhouse so check for these hand-types
-		if (!isFlush) {
-			for (int i = 0; i < 4;) {
-				int comp = hand[i] % 13;
-				// Loop until there is no longer a matching value, then calculate how many values were matched
-				for (int j = i + 1; j <= 5; ++j) {
-					if (j == 5 || comp != hand[j] % 13) {
-						if (j - i == 2) {
-							//Check if pair
-							if (isPair) {
-								isTwoPair = true;
-							}
-							//Check if triple
-							else if (isTriple) {
-								isFullHouse = true;
-							}
-							else {
-								//Otherwise pair
-								isPair = true;
-							}
-						}
-						//Check if pair
-						else if (j - i == 3) {
-							if (isPair) {
-								isFullHouse = true;
-							}
-							else {
-								//Otherwise tripple
-								isTriple = true;
-							}
-						}
-						else if (j - i == 4) {
-							//Is four of a kind
-							isQuadruple = true;
-						}
-						i += j - i;
-						break;
-					}
+
+		bool dealing = true;
+		while (dealing || slavesLeft > 0) {
+			if (dealing) {
+				double blockStart = MPI_Wtime();
+				int block = pollInterval.batches();
+				dealing = scheduler.takeBlock((uint64_t)block * HandBatch::SIZE, begin, end);
+				if (dealing) {
+					worker.drawRange(begin, end);
+					pollInterval.update(block, MPI_Wtime() - blockStart);
+				}
+				else {
+					threadFinished[0] = timer.elapsed();
 				}
 			}
-		}
-		// iIf there weren't two or more of a kind, it could be a straight
-		if (!(isPair || isTwoPair || isTriple || isFullHouse || isQuadruple)) {
-			// Check for a straight
-			for (int i = 1; i < 5; ++i) {
-				if (hand[0] % 13 != (hand[i] - i) % 13) {
-					isStraight = false;
+
+			// Serve the requests that have come in, waiting for them once there is nothing left to deal
+			while (slavesLeft > 0) {
+				int arrived = 1;
+				MPI_Status status;
+				PHASE_START(mark);
+				if (dealing)
+					MPI_Test(&request, &arrived, &status);
+				else
+					MPI_Wait(&request, &status);
+				PHASE_STOP(mpiPhases, PHASE_MPI_WAIT, mark);
+				if (!arrived)
 					break;
+
+				int slave = status.MPI_SOURCE;
+				for (int type = 0; type < NUM_HAND_TYPES; ++type)
+					counts[(HandType)type] += message[type];
+				if (message[NUM_HAND_TYPES]) {
+					// The slave has had the reply before, so it has finished sending
+					uint64_t* reply = &replies[2 * slave];
+					MPI_Wait(&replyRequests[slave], MPI_STATUS_IGNORE);
+					if (!scheduler.take(numThreads, reply[0], reply[1]))
+						reply[0] = reply[1] = 0;
+					MPI_Isend(reply, 2, MPI_UINT64_T, slave, TAG_CHUNK, MPI_COMM_WORLD, &replyRequests[slave]);
 				}
-			}
-			// Check for a straight with aces high (royal)
-			// Since it's sorted and there are no pairs or any kind, if the first is ace and the second is 10, then the rest must be J,Q,K
-			if (hand[0] % 13 == 0 && hand[1] % 13 == 9) {
-				isRoyal = true;
-				isStraight = true;
-			}
-		}
-		//Go through each hand and add the count to the frequency map. If it is the first time this hand has been found increase the hand-type counter
-		//Set up the frequency map
-		if (isFullHouse) {
-			if (++frequencyMap["     Full House"] == 1) {
-				++handTypeCount;
-			}
-		}
-		else if (isTwoPair) {
-			if (++frequencyMap["       Two Pair"] == 1) {
-				++handTypeCount;
-			}
-		}
-		else if (isTriple) {
-			if (++frequencyMap["Three of a Kind"] == 1) {
-				++handTypeCount;
-			}
-		}
-		else if (isPair) {
-			if (++frequencyMap["       One Pair"] == 1) {
-				++handTypeCount;
-			}
-		}
-		else if (isQuadruple) {
-			if (++frequencyMap[" Four of a Kind"] == 1) {
-				++handTypeCount;
-			}
-		}
-		else if (isRoyal && isFlush) {
-			if (++frequencyMap["    Royal Flush"] == 1) {
-				++handTypeCount;
-			}
-		}
-		else if (isStraight && isFlush) {
-			if (++frequencyMap[" Straight Flush"] == 1) {
-				++handTypeCount;
-			}
-		}
-		else if (isStraight) {
-			if (++frequencyMap["       Straight"] == 1) {
-				++handTypeCount;
-			}
-		}
-		else if (isFlush) {
-			if (++frequencyMap["          Flush"] == 1) {
-				++handTypeCount;
-			}
-		}
-		else {
-			if (++frequencyMap["        No Pair"] == 1) {
-				++handTypeCount;
+				else {
+					finished[slave] = timer.elapsed();
+					--slavesLeft;
+				}
+				if (slavesLeft > 0)
+					MPI_Irecv(message, NUM_HAND_TYPES + 1, MPI_UINT64_T, MPI_ANY_SOURCE, TAG_CHUNK_REQUEST, MPI_COMM_WORLD, &request);
 			}
 		}
-	} while (handTypeCount < 10);
-	//Stop Timer
-	duration = ((float)start) / CLOCKS_PER_SEC;
+	});
+	MPI_Waitall(numProcs, replyRequests.data(), MPI_STATUSES_IGNORE);
+	counts.add(pool.counts());
+	chunksSent = scheduler.chunks();
+
+	// The tail is the time the others spent waiting on the process that finished last
+	finished[0] = *max_element(threadFinished.begin(), threadFinished.end());
+	lastRank = (int)(max_element(finished.begin(), finished.end()) - finished.begin());
+	tailTime = finished[lastRank] - *min_element(finished.begin(), finished.end());
 }
 
 /*
-* Purpose: print out the hand to the console, useful for debugging
-* Parameters: Int array
-* Returns: None
+* Purpose: a slave's part of a --hands run. It asks for its next chunk as soon as it starts dealing
+*		   one, so the next is there when it finishes; every request carries the counts of the chunk
+*		   before. Once the master has no more it sends the counts of its last chunk and stops.
+* Parameters: None
 */
-void PokerHandsMPI::printHand(int hand[5]) {
-	for (int i = 0; i < 5; ++i) {
-		cout << hand[i] % 13 + 1;
-		if (hand[i] / 13 == 0) {
-			cout << "S";
-		}
-		else if (hand[i] / 13 == 1) {
-			cout << "H";
-		}
-		else if (hand[i] / 13 == 2) {
-			cout << "D";
-		}
-		else if (hand[i] / 13 == 3) {
-			cout << "C";
-		}
-		if (i != 4) {
-			cout << ",";
-		}
+void PokerHandsMPI::_fetchChunks() {
+	int numThreads = pool.size();
+	uint64_t message[NUM_HAND_TYPES + 1], chunk[2], next[2];
+	HandCounts reported;
+
+	_chunkMessage(message, reported, true);
+	PHASE_START(mark);
+	MPI_Send(message, NUM_HAND_TYPES + 1, MPI_UINT64_T, 0, TAG_CHUNK_REQUEST, MPI_COMM_WORLD);
+	MPI_Recv(chunk, 2, MPI_UINT64_T, 0, TAG_CHUNK, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+	PHASE_STOP(mpiPhases, PHASE_MPI_WAIT, mark);
+
+	while (chunk[0] < chunk[1]) {
+		_chunkMessage(message, reported, true);
+		MPI_Request requests[2];
+		MPI_Isend(message, NUM_HAND_TYPES + 1, MPI_UINT64_T, 0, TAG_CHUNK_REQUEST, MPI_COMM_WORLD, &requests[0]);
+		MPI_Irecv(next, 2, MPI_UINT64_T, 0, TAG_CHUNK, MPI_COMM_WORLD, &requests[1]);
+
+		uint64_t first = chunk[0], size = chunk[1] - chunk[0];
+		pool.run([first, size, numThreads](HandWorker& worker, int thread) {
+			uint64_t begin, end;
+			HandEnumerator::splitRange(size, numThreads, thread, begin, end);
+			worker.drawRange(first + begin, first + end);
+		});
+
+		PHASE_START(mark);
+		MPI_Waitall(2, requests, MPI_STATUSES_IGNORE);
+		PHASE_STOP(mpiPhases, PHASE_MPI_WAIT, mark);
+		chunk[0] = next[0];
+		chunk[1] = next[1];
 	}
-	cout << endl;
+
+	_chunkMessage(message, reported, false);
+	MPI_Send(message, NUM_HAND_TYPES + 1, MPI_UINT64_T, 0, TAG_CHUNK_REQUEST, MPI_COMM_WORLD);
+	counts = pool.counts();
 }
 
 /*
-* Purpose: Helper functions to see if it is one or two digit number.
-*		   This is used to format the report.
-* Parameters: Int
-* Returns: Int
+* Purpose: fill in a slave's message to the master: the counts dealt since its last message, and
+*		   whether it wants another chunk
+* Parameters: message - NUM_HAND_TYPES counts and the flag, reported - the counts sent so far, moved
+*			  up to the counts now, wantsMore - false for the last message
 */
-int countDigits(int num) {
-	if (num < 10) {
-		return 1;
-	}
-	else {
-		return countDigits(num / 10) + 1;
-	}
+void PokerHandsMPI::_chunkMessage(uint64_t* message, HandCounts& reported, bool wantsMore) {
+	const HandCounts& dealt = pool.counts();
+	for (int type = 0; type < NUM_HAND_TYPES; ++type)
+		message[type] = dealt[(HandType)type] - reported[(HandType)type];
+	message[NUM_HAND_TYPES] = wantsMore ? 1 : 0;
+	reported = dealt;
 }
 
 /*
-* Purpose: Count the number of digits and add spaces in front of hands generated and frequency.
-*		   This function is used for formatting the report.
-* Parameters: Int
-* Returns: None
+* Purpose: deal hands on every process until the stopping rule (a tolerance or a budget) says to stop.
+*		   After each batch a process starts summing the counts its threads published with every other
+*		   process (a non-blocking allreduce) if no sum is already under way, or tests the one that is.
+*		   Every process gets the same sum at the same point, so they all make the same decision from it
+*		   and stop together. The time budget is measured on the master's clock, which is the only one added in.
+*		   A resumed run adds the counts and time of the segments before it. With a checkpoint file the
+*		   processes also save the counts they added to a sum once checkpointSeconds have passed since the
+*		   last checkpoint, deciding from the master's time in the sum so they all do it at the same sum.
+*		   With a results file they decide the same way to gather the hands each process added to a sum
+*		   every snapshotSeconds, with a non-blocking gather, and the master publishes the snapshot once
+*		   the gather completes. The exact counts are then summed on the master.
+* Parameters: rank - the rank of this process, numProcs - the number of processes
 */
-void PokerHandsMPI::printNumber(int num) {
-	for (int i = countDigits(num); i < 25; ++i)
-		cout << " ";
-	cout << num;
+void PokerHandsMPI::processChecked(int rank, int numProcs) {
+	double startTime = MPI_Wtime();
+	atomic<unsigned> typesSeen(0);
+	atomic<bool> stop(false);
+	pool.start([&typesSeen, &stop](HandWorker& worker, int) { worker.drawUntilStopped(typesSeen, stop); });
+
+	// The counts of each hand type, then the master's elapsed time in microseconds
+	uint64_t local[NUM_HAND_TYPES + 1], total[NUM_HAND_TYPES + 1];
+	MPI_Request sumRequest = MPI_REQUEST_NULL;
+	double nextCheckpoint = checkpointSeconds;
+
+	// The hands of this process in the snapshot being gathered, and on the master those of every
+	// process and the sum and time the snapshot is of
+	uint64_t snapshotHands = 0;
+	vector<uint64_t> rankHands((rank == 0) ? numProcs : 0);
+	MPI_Request snapshotRequest = MPI_REQUEST_NULL;
+	HandCounts snapshotCounts;
+	double snapshotTime = 0, nextSnapshot = (rank == 0 && results.isOpen()) ? snapshotSeconds : 0;
+	MPI_Bcast(&nextSnapshot, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+	while (stopReason == STOP_NONE) {
+		pool.worker(0).drawBatch(typesSeen);
+
+		PHASE_START(mark);
+		if (sumRequest == MPI_REQUEST_NULL) {
+			HandCounts published = pool.publishedCounts();
+			copy(published.count.begin(), published.count.end(), local);
+			local[NUM_HAND_TYPES] = (rank == 0) ? (uint64_t)((MPI_Wtime() - startTime) * 1e6) : 0;
+			MPI_Iallreduce(local, total, NUM_HAND_TYPES + 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD, &sumRequest);
+		}
+
+		int summed;
+		MPI_Test(&sumRequest, &summed, MPI_STATUS_IGNORE);
+		if (summed) {
+			HandCounts sum;
+			copy(total, total + NUM_HAND_TYPES, sum.count.begin());
+			double elapsed = total[NUM_HAND_TYPES] / 1e6;
+			if (!checkpointFile.empty() && elapsed >= nextCheckpoint) {
+				_saveCheckpoint(rank, local, elapsed);
+				nextCheckpoint = elapsed + checkpointSeconds;
+			}
+			sum.add(checkpoint.previous);
+			if (nextSnapshot > 0 && elapsed >= nextSnapshot) {
+				// Gathers must be started in the same order everywhere, so the last one is finished first
+				if (snapshotRequest != MPI_REQUEST_NULL) {
+					MPI_Wait(&snapshotRequest, MPI_STATUS_IGNORE);
+					if (rank == 0)
+						results.publish(snapshotCounts, snapshotTime, rankHands, false);
+				}
+				snapshotHands = 0;
+				for (int type = 0; type < NUM_HAND_TYPES; ++type)
+					snapshotHands += local[type];
+				snapshotCounts = sum;
+				snapshotTime = checkpoint.previousElapsed + elapsed;
+				MPI_Igather(&snapshotHands, 1, MPI_UINT64_T, rankHands.data(), 1, MPI_UINT64_T, 0, MPI_COMM_WORLD, &snapshotRequest);
+				nextSnapshot = elapsed + snapshotSeconds;
+			}
+			stopReason = rule.check(sum, checkpoint.previousElapsed + elapsed);
+		}
+
+		if (snapshotRequest != MPI_REQUEST_NULL) {
+			int gathered;
+			MPI_Test(&snapshotRequest, &gathered, MPI_STATUS_IGNORE);
+			if (gathered && rank == 0)
+				results.publish(snapshotCounts, snapshotTime, rankHands, false);
+		}
+		PHASE_STOP(mpiPhases, PHASE_MPI_WAIT, mark);
+	}
+
+	if (snapshotRequest != MPI_REQUEST_NULL) {
+		MPI_Wait(&snapshotRequest, MPI_STATUS_IGNORE);
+		if (rank == 0)
+			results.publish(snapshotCounts, snapshotTime, rankHands, false);
+	}
+	stop = true;
+	pool.join();
+	duration = MPI_Wtime() - startTime;
+	reduceResults(0);
+	if (!checkpointFile.empty())
+		_saveCheckpoint(rank, pool.counts().count.data(), duration);
+	// A resumed run reports the hands of every segment
+	if (rank == 0)
+		counts.add(checkpoint.previous);
 }
 
 /*
-* Purpose: check if the slave sent in a new result
-* Parameters: msg - the potential new match the slave found
-* Returns: bool - true if a new match
+* Purpose: save the counts every process has dealt so far in this segment to the checkpoint file. The
+*		   counts are gathered on the master, which writes the one file, so it only has to be writable
+*		   from the master's host. Every process calls it at the same point. A checkpoint that can not be
+*		   written is reported and the run carries on, so the file keeps the last one that was.
+* Parameters: rank - the rank of this process, dealt - the hand-type counts of this process,
+*			  elapsed - seconds since this segment started on the master
 */
-bool PokerHandsMPI::checkForMatch(string msg) {
-	static map<string, int>  matches;
-	if (++matches[msg] == 1) {
-		return true;
-	}
-	else {
-		return false;
+void PokerHandsMPI::_saveCheckpoint(int rank, const uint64_t* dealt, double elapsed) {
+	double startTime = MPI_Wtime();
+	int numProcs = (int)checkpoint.rankCounts.size();
+	vector<uint64_t> all((rank == 0) ? numProcs * NUM_HAND_TYPES : 0);
+	MPI_Gather(dealt, NUM_HAND_TYPES, MPI_UINT64_T, all.data(), NUM_HAND_TYPES, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+	if (rank == 0) {
+		for (int r = 0; r < numProcs; ++r)
+			copy(&all[r * NUM_HAND_TYPES], &all[r * NUM_HAND_TYPES] + NUM_HAND_TYPES, checkpoint.rankCounts[r].count.begin());
+		checkpoint.elapsed = checkpoint.previousElapsed + elapsed;
+		string error;
+		if (!checkpoint.write(checkpointFile, error))
+			cerr << "Checkpoint: " << error << endl;
 	}
+	++checkpoints;
+	checkpointTime += MPI_Wtime() - startTime;
 }
 
 /*
-* Purpose: send a terminate message to the slaves
-* Parameters: numProcs - number of total process, to determine hom many messages to send
-* Returns: bool - all messages sent
+* Purpose: read the checkpoint a run resumes from on the master and send every process what it needs
+*		   to carry on: the seed and segment of its streams and the counts and time before this segment.
+*		   Every process calls it before it builds its workers.
+* Parameters: rank - the rank of this process, options - changed to carry on from the checkpoint,
+*			  resumed - set to the checkpoint
+* Returns: bool - false on every process if the master can not read the checkpoint or it does not match
 */
-bool PokerHandsMPI::terminateSlaves(int numProcs) {
-	int msgBuff = 0;
-	for (int p = 1; p < numProcs; ++p)
-		MPI_Send(&msgBuff, 1, MPI_INT, p, TAG_QUIT, MPI_COMM_WORLD);
+bool PokerHandsMPI::resumeCheckpoint(int rank, SimulationOptions& options, Checkpoint& resumed) {
+	int valid = 1;
+	if (rank == 0) {
+		string error;
+		if (!resumed.read(options.checkpointFile, error) || !resumed.resume(options, error)) {
+			cerr << "Checkpoint: " << error << endl;
+			valid = 0;
+		}
+	}
+	MPI_Bcast(&valid, 1, MPI_INT, 0, MPI_COMM_WORLD);
+	if (!valid)
+		return false;
 
+	MPI_Bcast(&options.seed, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+	MPI_Bcast(&options.segment, 1, MPI_UINT32_T, 0, MPI_COMM_WORLD);
+	MPI_Bcast(resumed.previous.count.data(), NUM_HAND_TYPES, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+	MPI_Bcast(&resumed.previousElapsed, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
 	return true;
 }
 
 /*
-* Purpose: add to final count the results from a slave
-* Parameters: result - number of results for the hand type
-*			   procID - the id of the process that returned this result
-*			   activeCount - decrement this when we get the last message from a slave process
+* Purpose: count every 5-card (or 7-card) hand once. Each process, the master included, walks its own
+*		   contiguous range of the colex order and the counts are summed on the master.
+* Parameters: rank - the rank of this process, numProcs - the number of processes
 */
-void PokerHandsMPI::tallyResult(int result, int procID, int& activeCount) {
-
-	// procRecvd - Used to track how many results have been received from each process,
-	// they come in in order and are done when all 10 results are received
-	static map<int, int> procRecvd;
-
-	int tallyThis = ++procRecvd[procID];
-
-	if (tallyThis == 1) {
-		frequencyMap["     Full House"] += result;
-	}
-	else if (tallyThis == 2) {
-		frequencyMap["       Two Pair"] += result;
-	}
-	else if (tallyThis == 3) {
-		frequencyMap[" Four of a Kind"] += result;
-	}
-	else if (tallyThis == 4) {
-		frequencyMap["Three of a Kind"] += result;
-	}
-	else if (tallyThis == 5) {
-		frequencyMap["       One Pair"] += result;
-	}
-	else if (tallyThis == 6) {
-		frequencyMap["    Royal Flush"] += result;
-	}
-	else if (tallyThis == 7) {
-		frequencyMap[" Straight Flush"] += result;
+void PokerHandsMPI::processExhaustive(int rank, int numProcs) {
+	double startTime = MPI_Wtime();
+
+	// The threads of this process take chunks of its range until none are left
+	uint64_t begin, end;
+	HandEnumerator::splitRange(HandStatistics::totalHands(cardsPerHand), numProcs, rank, begin, end);
+	HandCounts local;
+	if (tables.isOpen() && cardsPerHand == 5) {
+		// The hand-types of this range come straight from the strength table
+		tables.countRange(begin, end, local);
+		fromTable = true;
 	}
-	else if (tallyThis == 8) {
-		frequencyMap["       Straight"] += result;
-	}
-	else if (tallyThis == 9) {
-		frequencyMap["          Flush"] += result;
-	}
-	else if (tallyThis == 10) {
-		frequencyMap["        No Pair"] += result;
-		--activeCount;
+	else {
+		atomic<uint64_t> nextChunk(begin);
+		pool.run([&nextChunk, end](HandWorker& worker, int) { worker.enumerate(nextChunk, end); });
+		local = pool.counts();
 	}
+
+	MPI_Reduce(local.count.data(), counts.count.data(), NUM_HAND_TYPES, MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+	duration = MPI_Wtime() - startTime;
 }
 
 /*
-* Purpose: check with a non blocking receive, if any messages have been sent from any slave process
-* Parameters: matchesLeft - decremented if we find a new match
+* Purpose: draw the hand-type counts of a number of hands from their exact multinomial distribution instead
+*		   of dealing them. Each process draws the counts of its share of the hands from its own stream and
+*		   the counts are summed on the master. To validate, each process also deals its share one hand at
+*		   a time on its threads and those counts are summed in the same reduce.
+* Parameters: rank - the rank of this process, numProcs - the number of processes, numHands - hands in all,
+*			  validate - also deal the hands
 */
-void PokerHandsMPI::checkMessagesFromSlaves(int& matchesLeft, int& activeCount) {
-
-	static string msgBuff;
-	static int resultBuff;
-
-	static int recvFlagMatch;
-	static int recvFlagResult;
-
-	MPI_Status statusMatch;
-	MPI_Status statusResult;
-
-	static MPI_Request requestMatch = 0;
-	static MPI_Request requestResult = 0;
-
-	static bool listenMatch = false;
-	static bool listenResult = false;
-
-	if (requestMatch)
-	{
-		// Test to see if Match a message has "come in"
-		MPI_Test(&requestMatch, &recvFlagMatch, &statusMatch);
-		if (recvFlagMatch)
-		{
-			// Message has "come in"
-			if (statusMatch.MPI_TAG == TAG_DATA) {
-				// check if this is a first time match
-				if (checkForMatch(&msgBuff[0])) {
-					--matchesLeft;
-				}
-			}
-
-			// Reset the Request handle
-			requestMatch = 0;
-		}
-	}
-
-	if (!requestMatch)
-	{
-		// Start listening again for a new match message
-		listenMatch = true;
-		MPI_Irecv(&msgBuff[0], MAX_MSG_SIZE, MPI_CHAR, MPI_ANY_SOURCE, TAG_DATA, MPI_COMM_WORLD, &requestMatch);
-	}
-
-	if (requestResult)
-	{
-		// Test to see if a Result message has "come in"
-		MPI_Test(&requestResult, &recvFlagResult, &statusResult);
-
-		if (recvFlagResult)
-		{
-			// Message has "come in"
-			if (statusResult.MPI_TAG == TAG_RESULTS) {
-				tallyResult(resultBuff, statusResult.MPI_SOURCE, activeCount);
-			}
-			// Reset the Request handle
-			requestResult = 0;
-		}
+void PokerHandsMPI::processMultinomial(int rank, int numProcs, uint64_t numHands, bool validate) {
+	double startTime = MPI_Wtime();
+	uint64_t begin, end;
+	HandEnumerator::splitRange(numHands, numProcs, rank, begin, end);
+	HandCounts sampled = sampler.sample(end - begin);
+	duration = MPI_Wtime() - startTime;
+	multinomial = true;
+
+	if (validate) {
+		int numThreads = pool.size();
+		uint64_t share = end - begin;
+		pool.run([share, numThreads](HandWorker& worker, int thread) {
+			uint64_t threadBegin, threadEnd;
+			HandEnumerator::splitRange(share, numThreads, thread, threadBegin, threadEnd);
+			worker.drawHands(threadEnd - threadBegin);
+		});
 	}
 
-	if (!requestResult && activeCount > 0)
-	{
-		// Start listening again, for an int message/result
-		listenResult = true;
-		MPI_Irecv(&resultBuff, 1, MPI_INT, MPI_ANY_SOURCE, TAG_RESULTS, MPI_COMM_WORLD, &requestResult);
-	}
+	// The drawn counts, then the dealt counts
+	uint64_t local[2 * NUM_HAND_TYPES], total[2 * NUM_HAND_TYPES] = { 0 };
+	copy(sampled.count.begin(), sampled.count.end(), local);
+	copy(pool.counts().count.begin(), pool.counts().count.end(), local + NUM_HAND_TYPES);
+	MPI_Reduce(local, total, 2 * NUM_HAND_TYPES, MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+	copy(total, total + NUM_HAND_TYPES, counts.count.begin());
+	copy(total + NUM_HAND_TYPES, total + 2 * NUM_HAND_TYPES, dealtCounts.count.begin());
 }
 
 /*
-* Purpose: perform the function of the master process, simulating card hands if serial or processing results from the slaves
-* Parameters: numProcs- the of processes, if greater then one then there are slaves to manage
+* Purpose: validation of the multinomial engine on the master. Checks the drawn counts and the dealt counts
+*		   agree with each other (chi-square test of homogeneity) and each with the exact frequencies.
+* Returns: bool - true if all three tests pass
 */
-void PokerHandsMPI::processMaster(int numProcs) {
-	if (numProcs == 1)
-	{
-		setUpDeck();
-		randomizeDeck(deck, 52);
-		processSerial();
-	}
-	else {
-		// Start the timer
-		double startTime = MPI_Wtime();
-
-		bool isAllFound = false;
-		int activeCount = numProcs - 1;
-		int matchesLeft = 10;
-
-		// Get new hand types from slaves, exit when we get them all
-		bool slavesTerminated = false;
-		while (matchesLeft > 0 || activeCount > 0) {
-			checkMessagesFromSlaves(matchesLeft, activeCount);
-			if (matchesLeft == 0 && !slavesTerminated)
-				// Sends a TERMINATE message to each slave
-				slavesTerminated = terminateSlaves(numProcs);
-		}
-
-		duration = MPI_Wtime() - startTime;
-		// print out the results
-	}
+bool PokerHandsMPI::validateSampler() {
+	ReportFormatter::printRule(cout);
+	ReportFormatter::printComparison(cout, counts, dealtCounts, cardsPerHand);
+
+	int degreesOfFreedom;
+	double statistic = HandStatistics::homogeneityChiSquare(counts, dealtCounts, degreesOfFreedom);
+	bool passed = HandStatistics::passesHomogeneity(counts, dealtCounts)
+		&& HandStatistics::passesChiSquare(counts, cardsPerHand) && HandStatistics::passesChiSquare(dealtCounts, cardsPerHand);
+	ReportFormatter::printRule(cout);
+	cout << fixed << setprecision(3);
+	ReportFormatter::printField(cout, "Chi-Square", statistic);
+	ReportFormatter::printField(cout, "Deg. of Freedom", degreesOfFreedom);
+	ReportFormatter::printField(cout, "Multinomial Fit", HandStatistics::passesChiSquare(counts, cardsPerHand) ? "PASS" : "FAIL");
+	ReportFormatter::printField(cout, "Dealt Fit", HandStatistics::passesChiSquare(dealtCounts, cardsPerHand) ? "PASS" : "FAIL");
+	ReportFormatter::printField(cout, "Result", passed ? "PASS" : "FAIL");
+	return passed;
 }
 
 /*
-* Purpose: check with a non blocking receive, if any messages have been sent from the master process
-* Parameters: activeCount - decremented if the process is told to quit
+* Purpose: tell if this run stops by the stopping rule (--tolerance, --max-hands or --max-seconds)
+* Returns: bool
 */
-void PokerHandsMPI::checkMessageFromMaster(int& activeCount)
-{
-	static int msgBuff, recvFlag;
-	MPI_Status status;
-	static MPI_Request request;
-
-	if (request)
-	{
-		// Already listening for a message
-
-		// Test to see if a message has "come in"
-		MPI_Test(&request, &recvFlag, &status);
+bool PokerHandsMPI::isChecked() const {
+	return rule.isChecked();
+}
 
-		if (recvFlag)
-		{
-			// Message has "come in"
-			if (status.MPI_TAG == TAG_QUIT)
-				// Slave is quitting
-				activeCount--;
+/*
+* Purpose: self-test of an exhaustive run, checks the counts are exactly the number of hands of each type
+* Returns: bool - true if every count is exact
+*/
+bool PokerHandsMPI::checkExact() {
+	bool exact = HandStatistics::matchesExact(counts, cardsPerHand);
+	ReportFormatter::printField(cout, "Exact Counts", exact ? "PASS" : "FAIL");
+	return exact;
+}
 
-			// Reset the Request handle
-			request = 0;
+/*
+* Purpose: Hold'em equity of every matchup in a file. The master reads the file and sends it to every
+*		   process, so it only has to be on the master's host. Each process deals its part of the boards of
+*		   every matchup on its threads, and the tallies of the whole batch are summed on the master in one
+*		   reduce, which then prints them.
+* Parameters: rank - the rank of this process, numProcs - the number of processes, options - with the
+*			  name of the matchup file
+* Returns: bool - false on every process if the file can not be read or a matchup is not valid
+*/
+bool PokerHandsMPI::processEquity(int rank, int numProcs, const SimulationOptions& options) {
+	double startTime = MPI_Wtime();
+
+	// The length of the file, -1 if the master can not read it, then the file itself
+	string text;
+	long long length = -1;
+	if (rank == 0) {
+		ifstream file(options.equityFile.c_str(), ios::binary);
+		if (file) {
+			ostringstream contents;
+			contents << file.rdbuf();
+			text = contents.str();
+			length = (long long)text.size();
 		}
 	}
+	MPI_Bcast(&length, 1, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+	if (length < 0) {
+		if (rank == 0)
+			cerr << "Can not open " << options.equityFile << endl;
+		return false;
+	}
+	text.resize((size_t)length);
+	MPI_Bcast(&text[0], (int)length, MPI_CHAR, 0, MPI_COMM_WORLD);
+
+	// Every process reads the same text, so they all agree on whether it is valid
+	istringstream in(text);
+	vector<Matchup> matchups;
+	string error;
+	if (!EquityCalculator::readMatchups(in, matchups, error)) {
+		if (rank == 0)
+			cerr << options.equityFile << ", " << error << endl;
+		return false;
+	}
 
-	if (!request && activeCount > 0)
-	{
-		// Start listening again
-		MPI_Irecv(&msgBuff, 1, MPI_INT, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &request);
+	vector<EquityTally> tallies(matchups.size()), totals(matchups.size());
+	EquityCalculator::calculateAll(pool, options, rank, numProcs, matchups, tallies, &tables);
+	MPI_Reduce(&tallies[0].boards, &totals[0].boards, (int)matchups.size() * EQUITY_TALLY_VALUES, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+	duration = MPI_Wtime() - startTime;
+
+	if (rank == 0) {
+		ReportFormatter::printTitle(cout, (numProcs == 1) ? "Serial Version, Equity" : "Parallel Version, Equity");
+		for (size_t i = 0; i < matchups.size(); ++i)
+			EquityCalculator::printEquity(cout, matchups[i], totals[i], EquityCalculator::method(matchups[i], options, &tables));
+		cout << fixed << setprecision(3);
+		ReportFormatter::printField(cout, "Matchups", matchups.size());
+		ReportFormatter::printField(cout, "Elapsed Time (s)", duration);
+		ReportFormatter::printField(cout, "# of Processes", numProcs);
+		ReportFormatter::printField(cout, "# of Threads", pool.size());
+		ReportFormatter::printField(cout, "Seed", seed);
+		ReportFormatter::printField(cout, "Generator", RandomStream::typeName(generator));
+		if (tables.isOpen())
+			ReportFormatter::printField(cout, "Table Load (us)", 1e6 * tablesLoadTime);
+		ReportFormatter::printRule(cout);
 	}
+	return true;
 }
 
 /*
-* Purpose: perform the function of a slave process, simulating card hands and processing results
-* Parameters: rank - the rank of the slave process
+* Purpose: Map the precomputed tables PokerHandsTables wrote. Every process maps its own copy of the
+*		   file, so it must be readable from every host. Every process calls it.
+* Parameters: path - the table file
+* Returns: bool - false on every process if any of them could not map the file
 */
-void PokerHandsMPI::processSlave(int rank) {
-
-	MPI_Request request = 0;
-	string msg = "";
-	int isActive = 1;
-	int exitMessage = 0;
-	bool isFlush, isRoyal;
-
-	while (isActive) {
-
-
-		// Draw hands, tell the master if you get a new hand type
-		bool isPair = false, isTriple = false, isTwoPair = false, isFullHouse = false, isQuadruple = false;
-		isRoyal = false;
-		bool isStraight = true;
-		isFlush = true;
-		//b)  Simulate drawing a poker hand by referencing the first 5 cards in the deck data structure
-		//c) Analyze poker hand to identify which hand-type the poker hand represents and increment the corresponding element in the frequencies data structure
-		//Randomize then get the first five cards of the array 
-		randomizeDeck(deck, 52, rank);
-		for (int i = 0; i < 5; ++i) {
-			hand[i] = deck[i];
-			// check the suits for flushness while the hand is populated
-			if (hand[0] / 13 != hand[i] / 13) {
-				isFlush = false;
-			}
-		}
-		// Sort the hand array with STL sort.
-		sort(hand, hand + 5, sort_cards);
-		// if not flush, then we can have pairs, triples, quadruples, fullhouse etc so check for these
-		if (!isFlush) {
-			for (int i = 0; i < 4;) {
-				int comp = hand[i] % 13;
-				// loop until no longer a matching value, then calculate how many matched
-				for (int j = i + 1; j <= 5; ++j) {
-					if (j == 5 || comp != hand[j] % 13) {
-						if (j - i == 2) {
-							if (isPair) {
-								isTwoPair = true;
-							}
-							else if (isTriple) {
-								isFullHouse = true;
-							}
-							else {
-								isPair = true;
-							}
-						}
-						else if (j - i == 3) {
-							if (isPair) {
-								isFullHouse = true;
-							}
-							else {
-								isTriple = true;
-							}
-						}
-						else if (j - i == 4) {
-							isQuadruple = true;
-						}
-						i += j - i;
-						break;
-					}
-				}
-			}
-		}
-		// if there weren't two or more of a kind, it could be a straight
-		if (!(isPair || isTwoPair || isTriple || isFullHouse || isQuadruple)) {
-			// check for a straight
-			for (int i = 1; i < 5; ++i) {
-				if (hand[0] % 13 != (hand[i] - i) % 13) {
-					isStraight = false;
-					break;
-				}
-			}
-			// for a straight with aces high (royal)
-			// since it's sorted and there are no pairs or any kind, if the first is ace and the second is 10, then the rest must be J,Q,K
-			if (hand[0] % 13 == 0 && hand[1] % 13 == 9) {
-				isRoyal = true;
-				isStraight = true;
-			}
-		}
-		// check for a quit message
-		checkMessageFromMaster(isActive);
+bool PokerHandsMPI::loadTables(const string& path) {
+	string error;
+	double startTime = MPI_Wtime();
+	int loaded = tables.open(path, error) ? 1 : 0;
+	tablesLoadTime = MPI_Wtime() - startTime;
+	if (!loaded)
+		cerr << "Tables: " << error << endl;
+
+	int allLoaded;
+	MPI_Allreduce(&loaded, &allLoaded, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+	return allLoaded == 1;
+}
 
-		// if no exit, tally up the hand, and let the master know if it's a new one
-		if (isActive) {
-			if (isFullHouse) {
-				if (++frequencyMap["     Full House"] == 1) {
-					msg = "     Full House";
-					MPI_Isend(&msg[0], MAX_MSG_SIZE, MPI_CHAR, 0, TAG_DATA, MPI_COMM_WORLD, &request);
-				}
-			}
-			else if (isTwoPair) {
-				if (++frequencyMap["       Two Pair"] == 1) {
-					msg = "       Two Pair";
-					MPI_Isend(&msg[0], MAX_MSG_SIZE, MPI_CHAR, 0, TAG_DATA, MPI_COMM_WORLD, &request);
-				}
-			}
-			else if (isQuadruple) {
-				if (++frequencyMap[" Four of a Kind"] == 1) {
-					msg = " Four of a Kind";
-					MPI_Isend(&msg[0], MAX_MSG_SIZE, MPI_CHAR, 0, TAG_DATA, MPI_COMM_WORLD, &request);
-				}
-			}
-			else if (isTriple) {
-				if (++frequencyMap["Three of a Kind"] == 1) {
-					msg = "Three of a Kind";
-					MPI_Isend(&msg[0], MAX_MSG_SIZE, MPI_CHAR, 0, TAG_DATA, MPI_COMM_WORLD, &request);
-				}
-			}
-			else if (isPair) {
-				if (++frequencyMap["       One Pair"] == 1) {
-					msg = "       One Pair";
-					MPI_Isend(&msg[0], MAX_MSG_SIZE, MPI_CHAR, 0, TAG_DATA, MPI_COMM_WORLD, &request);
-				}
-			}
-			else if (isRoyal && isFlush) {
-				if (++frequencyMap["    Royal Flush"] == 1) {
-					msg = "    Royal Flush";
-					MPI_Isend(&msg[0], MAX_MSG_SIZE, MPI_CHAR, 0, TAG_DATA, MPI_COMM_WORLD, &request);
-				}
-			}
-			else if (isStraight && isFlush) {
-				if (++frequencyMap[" Straight Flush"] == 1) {
-					msg = " Straight Flush";
-					MPI_Isend(&msg[0], MAX_MSG_SIZE, MPI_CHAR, 0, TAG_DATA, MPI_COMM_WORLD, &request);
-				}
-			}
-			else if (isStraight) {
-				if (++frequencyMap["       Straight"] == 1) {
-					msg = "       Straight";
-					MPI_Isend(&msg[0], MAX_MSG_SIZE, MPI_CHAR, 0, TAG_DATA, MPI_COMM_WORLD, &request);
-				}
-			}
-			else if (isFlush) {
-				if (++frequencyMap["          Flush"] == 1) {
-					msg = "          Flush";
-					MPI_Isend(&msg[0], MAX_MSG_SIZE, MPI_CHAR, 0, TAG_DATA, MPI_COMM_WORLD, &request);
-				}
-			}
-			else {
-				if (++frequencyMap["        No Pair"] == 1) {
-					msg = "        No Pair";
-					MPI_Isend(&msg[0], MAX_MSG_SIZE, MPI_CHAR, 0, TAG_DATA, MPI_COMM_WORLD, &request);
-				}
-			}
+/*
+* Purpose: Open the results file on the master, which writes every snapshot of the run
+* Parameters: rank - the rank of this process, numProcs - the number of processes, options - with the
+*			  name and format of the results file
+* Returns: bool - false on every process if the master could not open the file
+*/
+bool PokerHandsMPI::openResults(int rank, int numProcs, const SimulationOptions& options) {
+	int opened = 1;
+	if (rank == 0) {
+		string error;
+		if (!results.open(options.resultsFile, options.resultFormat, numProcs, checkpoint.previousElapsed, error)) {
+			cerr << "Results: " << error << endl;
+			opened = 0;
 		}
 	}
-
-	// send the results then quit/finalize
-	MPI_Send(&frequencyMap["     Full House"], 1, MPI_INT, 0, TAG_RESULTS, MPI_COMM_WORLD);
-	MPI_Send(&frequencyMap["       Two Pair"], 1, MPI_INT, 0, TAG_RESULTS, MPI_COMM_WORLD);
-	MPI_Send(&frequencyMap[" Four of a Kind"], 1, MPI_INT, 0, TAG_RESULTS, MPI_COMM_WORLD);
-	MPI_Send(&frequencyMap["Three of a Kind"], 1, MPI_INT, 0, TAG_RESULTS, MPI_COMM_WORLD);
-	MPI_Send(&frequencyMap["       One Pair"], 1, MPI_INT, 0, TAG_RESULTS, MPI_COMM_WORLD);
-	MPI_Send(&frequencyMap["    Royal Flush"], 1, MPI_INT, 0, TAG_RESULTS, MPI_COMM_WORLD);
-	MPI_Send(&frequencyMap[" Straight Flush"], 1, MPI_INT, 0, TAG_RESULTS, MPI_COMM_WORLD);
-	MPI_Send(&frequencyMap["       Straight"], 1, MPI_INT, 0, TAG_RESULTS, MPI_COMM_WORLD);
-	MPI_Send(&frequencyMap["          Flush"], 1, MPI_INT, 0, TAG_RESULTS, MPI_COMM_WORLD);
-	MPI_Send(&frequencyMap["        No Pair"], 1, MPI_INT, 0, TAG_RESULTS, MPI_COMM_WORLD);
-
+	MPI_Bcast(&opened, 1, MPI_INT, 0, MPI_COMM_WORLD);
+	return opened == 1;
 }
 
 int main(int argc, char* argv[])
 {
-	if (MPI_Init(&argc, &argv) == MPI_SUCCESS)
+	int exitCode = 0;
+	// Only the main thread of each process makes MPI calls, the worker threads never do
+	int provided;
+	if (MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided) == MPI_SUCCESS)
 	{
 		int rank, numProcs;
 		// Obtain the # of processes
@@ -754,14 +934,70 @@ int main(int argc, char* argv[])
 			// Obtain the rank of this process
 			MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
-			if (rank == 0) {
-				PokerHandsMPI ph;
+			// Every rank reads the same command line, so every rank agrees on whether it is valid
+			SimulationOptions options;
+			bool valid = options.parse(argc, argv);
+			if (valid && options.selfTest) {
+				if (rank == 0)
+					cerr << "--selftest is only available in the serial program" << endl;
+				valid = false;
+			}
+			if (valid && options.threads > 1 && provided < MPI_THREAD_FUNNELED) {
+				if (rank == 0)
+					cerr << "--threads needs an MPI library with MPI_THREAD_FUNNELED support" << endl;
+				valid = false;
+			}
+			if (!valid) {
+				if (rank == 0)
+					options.printUsage(argv[0]);
+				MPI_Finalize();
+				return 1;
+			}
+
+			// Use the seed rank 0 was given or made, so the streams of all ranks come from one seed
+			MPI_Bcast(&options.seed, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+
+			// A resumed run carries on with the seed of the checkpoint and streams of its own
+			Checkpoint resumed;
+			if (options.resume && !PokerHandsMPI::resumeCheckpoint(rank, options, resumed)) {
+				MPI_Finalize();
+				return 1;
+			}
+
+			PokerHandsMPI ph(options, rank, numProcs, resumed);
+			if (!options.tablesFile.empty() && !ph.loadTables(options.tablesFile)) {
+				MPI_Finalize();
+				return 1;
+			}
+			if (!options.resultsFile.empty() && !ph.openResults(rank, numProcs, options)) {
+				MPI_Finalize();
+				return 1;
+			}
+			if (!options.equityFile.empty()) {
+				exitCode = ph.processEquity(rank, numProcs, options) ? 0 : 1;
+				MPI_Finalize();
+				return exitCode;
+			}
+			if (options.exhaustive)
+				ph.processExhaustive(rank, numProcs);
+			else if (options.multinomialHands > 0)
+				ph.processMultinomial(rank, numProcs, options.multinomialHands, options.validate);
+			else if (options.hands > 0)
+				ph.processHands(rank, numProcs);
+			else if (ph.isChecked())
+				ph.processChecked(rank, numProcs);
+			else if (rank == 0)
 				ph.processMaster(numProcs);
+			else
+				ph.processSlave();
+
+			ph.gatherThroughput(numProcs);
+			if (rank == 0) {
 				ph.report(numProcs);
-			}
-			else {
-				PokerHandsMPI ph;
-				ph.processSlave(rank);
+				if (options.exhaustive)
+					exitCode = ph.checkExact() ? 0 : 1;
+				if (options.validate)
+					exitCode = ph.validateSampler() ? 0 : 1;
 			}
 		}
 		else
@@ -770,5 +1006,5 @@ int main(int argc, char* argv[])
 		}
 		MPI_Finalize();
 	}
+	return exitCode;
 }
-
@@ -11,50 +11,114 @@
 *      Simulation results are then output to the console.
 */
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../PokerHandsCore/Checkpoint.h"
+#include "../PokerHandsCore/ChunkScheduler.h"
+#include "../PokerHandsCore/HandCounts.h"
+#include "../PokerHandsCore/HandTables.h"
+#include "../PokerHandsCore/MultinomialSampler.h"
+#include "../PokerHandsCore/PhaseTimer.h"
+#include "../PokerHandsCore/PollInterval.h"
+#include "../PokerHandsCore/Random.h"
+#include "../PokerHandsCore/ResultsSink.h"
+#include "../PokerHandsCore/SimulationOptions.h"
+#include "../PokerHandsCore/StoppingRule.h"
+#include "../PokerHandsCore/WorkerPool.h"
+
 class PokerHandsMPI {
 public:
 
 	//Constructor/Deconstructor
-	PokerHandsMPI();
+	PokerHandsMPI(const SimulationOptions& options, int rank, int numProcs, const Checkpoint& resumed);
 	~PokerHandsMPI();
 
-	int deck[52];
-	int hand[5];
-
-	std::map<std::string, int> frequencyMap;
-	std::map<std::string, int>::iterator it;
+	HandCounts counts;
 
 
 	//Public Methods
 	void report(int numProcs);
 	void processMaster(int numProcs);
-	void processSlave(int rank);
+	void processSlave();
+	void processExhaustive(int rank, int numProcs);
+	void processChecked(int rank, int numProcs);
+	void processHands(int rank, int numProcs);
+	void processMultinomial(int rank, int numProcs, uint64_t numHands, bool validate);
+	bool processEquity(int rank, int numProcs, const SimulationOptions& options);
+	bool loadTables(const std::string& path);
+	bool openResults(int rank, int numProcs, const SimulationOptions& options);
+	bool validateSampler();
+	bool isChecked() const;
+	bool checkExact();
+	void gatherThroughput(int numProcs);
 
+	// Public static method
+	static bool resumeCheckpoint(int rank, SimulationOptions& options, Checkpoint& resumed);
 
-private:
-	// Private static methods
-	static void _seedRNG(int rank);
-	static int getRandom(int rank);
-	static void printHand(int hand[5]);
-	static void printNumber(int num);
-
-	void setUpDeck();
-	void randomizeDeck(int arr[], int n, int rank = 1);
 
+private:
 	void processSerial();
+	void _printThroughput(int numProcs);
+	void _saveCheckpoint(int rank, const uint64_t* dealt, double elapsed);
+	void _serveChunks(int numProcs);
+	void _fetchChunks();
+	void _chunkMessage(uint64_t* message, HandCounts& reported, bool wantsMore);
 
-	bool terminateSlaves(int numProcs);
-	void checkMessagesFromSlaves(int& matchesLeft, int& activeCount);
-	void checkMessageFromMaster(int& activeCount);
-
-	bool checkForMatch(std::string msg);
-	void tallyResult(int result, int procID, int& activeCount);
+	uint64_t reduceResults(uint64_t sent);
 
 	//Member Variables
 	double duration;
-	std::clock_t start;
+	double reportDelay;
+	WorkerPool pool;
+	StoppingRule rule;
+	StopReason stopReason;
+	// A --hands run: the hands in all, and on the master the guided chunks sent to the slaves, the
+	// time from the first process running out of hands to the last one finishing and that process
+	uint64_t numHands;
+	bool reproducible;
+	uint64_t chunksSent;
+	double tailTime;
+	int lastRank;
+	MultinomialSampler sampler;
+	bool multinomial;
+	// Precomputed tables, mapped from the --tables file by every process
+	HandTables tables;
+	double tablesLoadTime;
+	bool fromTable;
+	// The checkpoint of the run, with the counts of the segments before this one when it was resumed
+	Checkpoint checkpoint;
+	std::string checkpointFile;
+	double checkpointSeconds;
+	int checkpoints;
+	double checkpointTime;
+	// Snapshots of the run written by the master as it goes, see ResultsSink.h
+	ResultsSink results;
+	double snapshotSeconds;
+	// Counts of the hands dealt to validate the multinomial engine, summed on the master
+	HandCounts dealtCounts;
+	RngType generator;
+	uint64_t seed;
+	bool exhaustive;
+	int cardsPerHand;
 
-	static bool _seeded;
+	// Throughput of every process, gathered on the master
+	std::vector<uint64_t> threadHands;
+	std::vector<double> rankTimes;
+	std::vector<char> hostNames;
+	// Cycles the main thread spent in MPI calls while dealing, and the phases of every thread of
+	// every process summed on the master (only with PHF_PHASE_TIMING)
+	PhaseTimes mpiPhases;
+	PhaseTimes phases;
+	// How often a slave checks for the quit, and what the checks cost. On the master after
+	// gatherThroughput: the checks, seconds spent in them and main thread hands of every slave
+	// summed, and the longest time any slave dealt before seeing the quit.
+	PollInterval pollInterval;
+	uint64_t polls;
+	double pollSeconds;
+	uint64_t pollHands;
+	double quitLatency;
 
 };
 #endif;
\ No newline at end of file
@@ -9,27 +9,42 @@
 */
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <ctime>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
-#include <map>
 #include <string>
 #include <time.h>
+#include <vector>
 
 #include "PokerHandsSerial.h"
+#include "../PokerHandsCore/EquityCalculator.h"
+#include "../PokerHandsCore/HandEnumerator.h"
+#include "../PokerHandsCore/HandStatistics.h"
+#include "../PokerHandsCore/PhaseTimer.h"
+#include "../PokerHandsCore/ReportFormatter.h"
 
 using namespace std;
 
-//Globals
-bool PokerHandsSerial::_seeded = false;
-
 //Constructor 
-PokerHandsSerial::PokerHandsSerial(){
-	PokerHandsSerial::setUpDeck();
-	for (int i = 0; i < 5; ++i) {
-		hand[i] = deck[i];
-	}
+PokerHandsSerial::PokerHandsSerial(const SimulationOptions& options, const Checkpoint& resumed) : pool(options, 0), rule(options), sampler(options, 0), checkpoint(resumed){
+	stopReason = STOP_NONE;
+	numHands = options.hands;
+	reproducible = options.reproducible;
+	multinomial = false;
+	tablesLoadTime = 0;
+	fromTable = false;
+	checkpoint.begin(options, 1);
+	checkpointFile = options.checkpointFile;
+	checkpointSeconds = options.checkpointSeconds;
+	checkpoints = 0;
+	checkpointTime = 0;
+	snapshotSeconds = options.snapshotSeconds;
+	seed = options.seed;
+	generator = options.generator;
+	cardsPerHand = options.cardsPerHand;
 }
 
 //Deconstructor
@@ -37,289 +52,373 @@ PokerHandsSerial::~PokerHandsSerial(){
 }
 
 /*
-* Purpose: Add 52 cards as integers to the deck
+* Purpose: Deal hands on every thread of the pool. Each HandWorker deals batches from its own deck and
+*		   stream, classifies them and adds them to its own counts. All threads stop once one of every hand
+*		   type has been found by any of them, a checked run once its stopping rule says so, or a --hands
+*		   run once the threads have dealt their share.
 * Parameters: None
 * Returns: None
 */
-void PokerHandsSerial::setUpDeck(){
-	for (int i = 1; i <= 52; ++i)
-	{
-		deck[i - 1] = i;
+void PokerHandsSerial::drawHands() {
+	Stopwatch timer;
+	if (rule.isChecked()) {
+		_drawUntilRule();
+	}
+	else if (numHands > 0) {
+		_dealSplit(numHands);
+	}
+	else {
+		atomic<unsigned> typesSeen(0);
+		pool.run([&typesSeen](HandWorker& worker, int) { worker.drawUntilAllFound(typesSeen); });
+		stopReason = STOP_ALL_TYPES;
 	}
+	counts = pool.counts();
+	duration = timer.elapsed();
+	if (!checkpointFile.empty())
+		_saveCheckpoint(counts, duration);
+	// A resumed run reports the hands of every segment
+	counts.add(checkpoint.previous);
 }
 
-/* 
-* Purpose: Swap random elements from randomizeDeck()
-* Parameters: Int pointer to ls, rs
+/*
+* Purpose: Deal hands on every thread until the stopping rule (a tolerance or a budget) says to stop.
+*		   This thread deals too and checks the rule against the counts the threads published after
+*		   each of its batches, together with those of the segments before this one when it resumed.
+*		   With a checkpoint file it also saves the published counts every checkpointSeconds, and with a
+*		   results file it publishes a snapshot of them every snapshotSeconds.
+* Parameters: None
 * Returns: None
 */
-void swap(int *ls, int *rs)
-{
-	int temp = *ls;
-	*ls = *rs;
-	*rs = temp;
+void PokerHandsSerial::_drawUntilRule() {
+	Stopwatch timer;
+	atomic<unsigned> typesSeen(0);
+	atomic<bool> stop(false);
+	pool.start([&typesSeen, &stop](HandWorker& worker, int) { worker.drawUntilStopped(typesSeen, stop); });
+
+	double nextCheckpoint = checkpointSeconds, nextSnapshot = snapshotSeconds;
+	do {
+		pool.worker(0).drawBatch(typesSeen);
+		double elapsed = timer.elapsed();
+		HandCounts published = pool.publishedCounts();
+		uint64_t dealt = published.total();
+		if (!checkpointFile.empty() && elapsed >= nextCheckpoint) {
+			_saveCheckpoint(published, elapsed);
+			nextCheckpoint = elapsed + checkpointSeconds;
+		}
+		published.add(checkpoint.previous);
+		if (results.isOpen() && elapsed >= nextSnapshot) {
+			results.publish(published, checkpoint.previousElapsed + elapsed, vector<uint64_t>(1, dealt), false);
+			nextSnapshot = elapsed + snapshotSeconds;
+		}
+		stopReason = rule.check(published, checkpoint.previousElapsed + elapsed);
+	} while (stopReason == STOP_NONE);
+
+	stop = true;
+	pool.join();
 }
 
 /*
-* Purpose: Randomizes the deck of integers
-* Parameters: Int array and Int
+* Purpose: Save the counts dealt so far in this segment to the checkpoint file. The other threads keep
+*		   dealing while this one writes it. A checkpoint that can not be written is reported and the
+*		   run carries on, so the file keeps the last one that was.
+* Parameters: HandCounts dealt in this segment, double seconds since this segment started
 * Returns: None
 */
-void PokerHandsSerial::randomizeDeck(int arr[], int n){
-	//Start from the last element ad swap one by one.
-	for (int i = n - 1; i >= 0; i--)
-	{
-		//pick a random index from 0 - i
-		int j = getRandom();
-
-		//Swap deck[i] with the element at random index
-		swap(&deck[i], &arr[j]);
-	}
+void PokerHandsSerial::_saveCheckpoint(const HandCounts& dealt, double elapsed) {
+	Stopwatch timer;
+	checkpoint.rankCounts[0] = dealt;
+	checkpoint.elapsed = checkpoint.previousElapsed + elapsed;
+	string error;
+	if (!checkpoint.write(checkpointFile, error))
+		cerr << "Checkpoint: " << error << endl;
+	++checkpoints;
+	checkpointTime += timer.elapsed();
 }
 
 /*
-* Purpose: Sort the hand of 5 cards to determine its suit and rank
-* Parameters: const int pointer to ls, rs
-* Returns:
+* Purpose: Counts every 5-card (or 7-card) hand once by walking them in colex order instead of dealing them.
+*		   With the tables loaded the 5-card hand-types are read from the strength table instead.
+* Parameters: None
+* Returns: None
 */
-bool sort_cards(const int& ls, const int& rs) {
-	return ls % 13 < rs % 13;
+void PokerHandsSerial::enumerateHands() {
+	atomic<uint64_t> nextChunk(0);
+	uint64_t end = HandStatistics::totalHands(cardsPerHand);
+	Stopwatch timer;
+	if (tables.isOpen() && cardsPerHand == 5) {
+		tables.countRange(0, end, counts);
+		fromTable = true;
+	}
+	else {
+		pool.run([&nextChunk, end](HandWorker& worker, int) { worker.enumerate(nextChunk, end); });
+		counts = pool.counts();
+	}
+	duration = timer.elapsed();
 }
 
 /*
-* Purpose: Creates a seed if it hasn't already been seeded and gets a random number
-* Parameters: void
-* Returns: A random int between 0 and 51
+* Purpose: Draws the hand-type counts of a number of hands from their exact multinomial distribution
+*		   instead of dealing them, for when only the frequencies are wanted
+* Parameters: uint64_t numHands
+* Returns: None
 */
-int PokerHandsSerial::getRandom(void)
-{
-	if (!_seeded)
-		_seedRNG();
-
-	return rand() % 52;
+void PokerHandsSerial::sampleCounts(uint64_t numHands) {
+	Stopwatch timer;
+	counts = sampler.sample(numHands);
+	duration = timer.elapsed();
+	multinomial = true;
 }
 
 /*
-* Purpose: Checks if seeded flag needs to be seeded
-* Parameters: void
+* Purpose:Report total number of poker hands generated and absolute and relative frequencies for each of the ten hand-types
+* Parameters: None
 * Returns: None
 */
-void PokerHandsSerial::_seedRNG(void)
-{
-	// Seed the random number generator
-	srand((int)(time(0)));
+void PokerHandsSerial::report(){
+	// The final snapshot is written before the report, so the two never mix on the console
+	if (results.isOpen()) {
+		results.publish(counts, checkpoint.previousElapsed + duration, vector<uint64_t>(1, counts.total() - checkpoint.previous.total()), true);
+		results.close();
+	}
+	ReportFormatter::printCounts(cout, counts);
 
-	_seeded = true;
+	ReportFormatter::printRule(cout);
+	cout << fixed << setprecision(3);
+	ReportFormatter::printField(cout, "Hands Generated", counts.total());
+	ReportFormatter::printField(cout, "Elapsed Time (s)", duration);
+	ReportFormatter::printField(cout, "# of Threads", pool.size());
+	ReportFormatter::printField(cout, "Seed", seed);
+	ReportFormatter::printField(cout, "Generator", RandomStream::typeName(generator));
+	ReportFormatter::printField(cout, "Cards per Hand", cardsPerHand);
+	ReportFormatter::printField(cout, "Classifier", (cardsPerHand == 7) ? "7-card masks" : BatchClassifier::levelName(pool.worker(0).classifierLevel()));
+	ReportFormatter::printField(cout, "Engine", multinomial ? "multinomial" : fromTable ? "table" : reproducible ? "dealt by hand index" : "dealt hands");
+	if (tables.isOpen())
+		ReportFormatter::printField(cout, "Table Load (us)", 1e6 * tablesLoadTime);
+	if (checkpoint.segment > 0) {
+		ReportFormatter::printField(cout, "Segment", checkpoint.segment);
+		ReportFormatter::printField(cout, "Resumed Hands", checkpoint.previous.total());
+		ReportFormatter::printField(cout, "Resumed Time (s)", checkpoint.previousElapsed);
+	}
+	if (checkpoints > 0) {
+		ReportFormatter::printField(cout, "Checkpoints", checkpoints);
+		ReportFormatter::printField(cout, "Checkpoint (ms)", 1e3 * checkpointTime);
+		ReportFormatter::printField(cout, "Checkpoint (%)", 100.0 * checkpointTime / duration);
+	}
+
+	if (rule.isChecked()) {
+		ReportFormatter::printField(cout, "Stopped By", StoppingRule::reasonName(stopReason));
+		cout << setprecision(6);
+		ReportFormatter::printField(cout, "Worst +/- (%)", 100.0 * HandStatistics::worstRelativeHalfWidth(counts));
+		ReportFormatter::printRule(cout);
+		ReportFormatter::printIntervals(cout, counts);
+	}
+	// Where the threads' time went, when built with PHF_PHASE_TIMING
+	if (PhaseTimer::enabled() && !multinomial && !fromTable) {
+		ReportFormatter::printRule(cout);
+		ReportFormatter::printPhases(cout, pool.phases(), counts.total() - checkpoint.previous.total(), duration * pool.size());
+	}
 }
 
 /*
-* Purpose: Helper functions to see if it is one or two digit number.
-*		   This is used to format the report.
-* Parameters: Int
-* Returns: Int
+* Purpose: Statistical check of the dealing. Deals and classifies a number of hands, split between
+*		   the threads, and tests the hand-type counts against the exact frequencies with a chi-square test.
+* Parameters: Int numHands
+* Returns: bool - true if the counts are consistent with the exact frequencies
 */
-int countDigits(int num) {
-	if (num < 10) {
-		return 1;
-	}
-	else {
-		return countDigits(num / 10) + 1;
+bool PokerHandsSerial::selfTest(int numHands) {
+	int numThreads = pool.size();
+	_dealSplit(numHands);
+	counts = pool.counts();
+
+	cout << "        Hand Type                 Observed          Expected\n";
+	ReportFormatter::printRule(cout);
+	cout << fixed << setprecision(1);
+	for (int type = NUM_HAND_TYPES - 1; type >= 0; --type) {
+		cout << "  " << setw(15) << ReportFormatter::handTypeName((HandType)type) << setw(25) << counts[(HandType)type]
+			<< setw(18) << HandStatistics::exactFrequency((HandType)type, cardsPerHand) * numHands << '\n';
 	}
+
+	int degreesOfFreedom;
+	double statistic = HandStatistics::chiSquare(counts, degreesOfFreedom, cardsPerHand);
+	bool passed = HandStatistics::passesChiSquare(counts, cardsPerHand);
+	ReportFormatter::printRule(cout);
+	cout << fixed << setprecision(3);
+	ReportFormatter::printField(cout, "Chi-Square", statistic);
+	ReportFormatter::printField(cout, "Deg. of Freedom", degreesOfFreedom);
+	ReportFormatter::printField(cout, "# of Threads", numThreads);
+	ReportFormatter::printField(cout, "Result", passed ? "PASS" : "FAIL");
+	return passed;
 }
 
 /*
-* Purpose: Simulates drawing a poker hand by referencing the first 5 cards in the deck data structure.
-*		   Analyzes the hand to identify which hand-type the had represents and increments the corresponding
-*		   element in the frequencies data structure. End the loop when one of every hand type has been found.
-* Parameters: None
+* Purpose: Deals and classifies a number of hands split between the threads
+* Parameters: uint64_t numHands
 * Returns: None
 */
-void PokerHandsSerial::drawHands() {
-	int handTypeCount = 0;
-	clock_t start;
-	do {
-		//Start the clock
-		start = clock();
-		bool isPair = false, isTriple = false, isTwoPair = false, isFullHouse = false, isQuadruple = false, isRoyal = false;
-		bool isStraight = true, isFlush = true;
-		//Randomize the deck of cards
-		randomizeDeck(deck, 52);
-		for (int i = 0; i < 5; ++i) {
-			hand[i] = deck[i];
-			// Check the suits for flushness while the hand is populated
-			if (hand[0] / 13 != hand[i] / 13) {
-				isFlush = false;
-			}
-		}
-		// Sort the hand array with STL sort.
-		sort(hand, hand + 5, sort_cards);
-		// If not flush, then we can have pairs, triples, quadruples, fullhouse so check for these hand-types
-		if (!isFlush) {
-			for (int i = 0; i < 4;) {
-				int comp = hand[i] % 13;
-				// Loop until there is no longer a matching value, then calculate how many values were matched
-				for (int j = i + 1; j <= 5; ++j) {
-					if (j == 5 || comp != hand[j] % 13) {
-						if (j - i == 2) {
-							//Check if pair
-							if (isPair) {
-								isTwoPair = true;
-							}
-							//Check if triple
-							else if (isTriple) {
-								isFullHouse = true;
-							}
-							else {
-								//Otherwise pair
-								isPair = true;
-							}
-						}
-						//Check if pair
-						else if (j - i == 3) {
-							if (isPair) {
-								isFullHouse = true;
-							}
-							else {
-								//Otherwise tripple
-								isTriple = true;
-							}
-						}
-						else if (j - i == 4) {
-							//Is four of a kind
-							isQuadruple = true;
-						}
-						i += j - i;
-						break;
-					}
-				}
-			}
-		}
-		// If there weren't two or more of a kind, it could be a straight
-		if (!(isPair || isTwoPair || isTriple || isFullHouse || isQuadruple)) {
-			// Check for a straight
-			for (int i = 1; i < 5; ++i) {
-				if (hand[0] % 13 != (hand[i] - i) % 13) {
-					isStraight = false;
-					break;
-				}
-			}
-			// Check for a straight with aces high (royal)
-			// Since it's sorted and there are no pairs or any kind, if the first is ace and the second is 10, then the rest must be J,Q,K
-			if (hand[0] % 13 == 0 && hand[1] % 13 == 9) {
-				isRoyal = true;
-				isStraight = true;
-			}
-		}
-		//Go through each hand and add the count to the frequency map. If it is the first time this hand has been found increase the hand-type counter
-		//Set up the frequency map
-		if (isFullHouse) {
-			if (++frequencyMap["     Full House"] == 1) {
-				++handTypeCount;
-			}
-		}
-		else if (isTwoPair) {
-			if (++frequencyMap["       Two Pair"] == 1) {
-				++handTypeCount;
-			}
-		}
-		else if (isTriple) {
-			if (++frequencyMap["Three of a Kind"] == 1) {
-				++handTypeCount;
-			}
-		}
-		else if (isPair) {
-			if (++frequencyMap["       One Pair"] == 1) {
-				++handTypeCount;
-			}
-		}
-		else if (isQuadruple) {
-			if (++frequencyMap[" Four of a Kind"] == 1) {
-				++handTypeCount;
-			}
-		}
-		else if (isRoyal && isFlush) {
-			if (++frequencyMap["    Royal Flush"] == 1) {
-				++handTypeCount;
-			}
-		}
-		else if (isStraight && isFlush) {
-			if (++frequencyMap[" Straight Flush"] == 1) {
-				++handTypeCount;
-			}
-		}
-		else if (isStraight) {
-			if (++frequencyMap["       Straight"] == 1) {
-				++handTypeCount;
-			}
-		}
-		else if (isFlush) {
-			if (++frequencyMap["          Flush"] == 1) {
-				++handTypeCount;
-			}
-		}
-		else {
-			if (++frequencyMap["        No Pair"] == 1) {
-				++handTypeCount;
-			}
-		}
-	} while (handTypeCount < 10);
-	//Stop Timer
-	duration = ((float)start) / CLOCKS_PER_SEC;
+void PokerHandsSerial::_dealSplit(uint64_t numHands) {
+	int numThreads = pool.size();
+	pool.run([numHands, numThreads](HandWorker& worker, int thread) {
+		uint64_t begin, end;
+		HandEnumerator::splitRange(numHands, numThreads, thread, begin, end);
+		worker.drawRange(begin, end);
+	});
 }
 
 /*
-* Purpose:Report total number of poker hands generated and absolute and relative frequencies for each of the ten hand-types
+* Purpose: Validation of the multinomial engine. Deals the same number of hands one at a time and checks
+*		   the drawn counts and the dealt counts agree with each other (chi-square test of homogeneity)
+*		   and each with the exact frequencies.
+* Parameters: uint64_t numHands
+* Returns: bool - true if all three tests pass
+*/
+bool PokerHandsSerial::validateSampler(uint64_t numHands) {
+	_dealSplit(numHands);
+	const HandCounts& dealt = pool.counts();
+
+	ReportFormatter::printRule(cout);
+	ReportFormatter::printComparison(cout, counts, dealt, cardsPerHand);
+
+	int degreesOfFreedom;
+	double statistic = HandStatistics::homogeneityChiSquare(counts, dealt, degreesOfFreedom);
+	bool passed = HandStatistics::passesHomogeneity(counts, dealt)
+		&& HandStatistics::passesChiSquare(counts, cardsPerHand) && HandStatistics::passesChiSquare(dealt, cardsPerHand);
+	ReportFormatter::printRule(cout);
+	cout << fixed << setprecision(3);
+	ReportFormatter::printField(cout, "Chi-Square", statistic);
+	ReportFormatter::printField(cout, "Deg. of Freedom", degreesOfFreedom);
+	ReportFormatter::printField(cout, "Multinomial Fit", HandStatistics::passesChiSquare(counts, cardsPerHand) ? "PASS" : "FAIL");
+	ReportFormatter::printField(cout, "Dealt Fit", HandStatistics::passesChiSquare(dealt, cardsPerHand) ? "PASS" : "FAIL");
+	ReportFormatter::printField(cout, "Result", passed ? "PASS" : "FAIL");
+	return passed;
+}
+
+/*
+* Purpose: Self-test of an exhaustive run. Checks the counts are exactly the number of hands of each type.
 * Parameters: None
-* Returns: None
+* Returns: bool - true if every count is exact
 */
-void PokerHandsSerial::report(){
-	//Get the total hands generated
-	unsigned int handsGenerated = 0;
-	for (std::map<string, int>::iterator it = frequencyMap.begin(); it != frequencyMap.end(); ++it)
-	{
-		handsGenerated += it->second;
+bool PokerHandsSerial::checkExact() {
+	bool exact = HandStatistics::matchesExact(counts, cardsPerHand);
+	ReportFormatter::printField(cout, "Exact Counts", exact ? "PASS" : "FAIL");
+	return exact;
+}
+
+/*
+* Purpose: Hold'em equity of every matchup in a file. The threads take the matchups one at a time.
+* Parameters: SimulationOptions with the name of the matchup file
+* Returns: bool - false if the file can not be read or a matchup is not valid
+*/
+bool PokerHandsSerial::calculateEquity(const SimulationOptions& options) {
+	ifstream file(options.equityFile.c_str());
+	vector<Matchup> matchups;
+	string error;
+	if (!file) {
+		cerr << "Can not open " << options.equityFile << endl;
+		return false;
 	}
-	//Print out Hand Type and Frequency and relative frequency
-	for (std::map<string, int>::iterator it = frequencyMap.begin(); it != frequencyMap.end(); ++it)
-	{
-		cout << fixed << setprecision(6);
-		cout << "  " << it->first;
-		printNumber(it->second);
-		//Calculate relative frequency
-		double value = 100.0 * (it->second) / handsGenerated;
-		if (value < 10.0)
-			cout << " ";
-		cout << "                    " << value << '\n';
+	if (!EquityCalculator::readMatchups(file, matchups, error)) {
+		cerr << options.equityFile << ", " << error << endl;
+		return false;
 	}
 
+	Stopwatch timer;
+	vector<EquityTally> tallies(matchups.size());
+	EquityCalculator::calculateAll(pool, options, 0, 1, matchups, tallies, &tables);
+	duration = timer.elapsed();
+
+	for (size_t i = 0; i < matchups.size(); ++i)
+		EquityCalculator::printEquity(cout, matchups[i], tallies[i], EquityCalculator::method(matchups[i], options, &tables));
 	cout << fixed << setprecision(3);
-	cout << "--------------------------------------------------------------------------------";
-	cout << "  Hands Generated: " << handsGenerated << endl;
-	cout << " Elapsed Time (s): " << duration << endl;
+	ReportFormatter::printField(cout, "Matchups", matchups.size());
+	ReportFormatter::printField(cout, "Elapsed Time (s)", duration);
+	ReportFormatter::printField(cout, "# of Threads", pool.size());
+	ReportFormatter::printField(cout, "Seed", seed);
+	ReportFormatter::printField(cout, "Generator", RandomStream::typeName(generator));
+	if (tables.isOpen())
+		ReportFormatter::printField(cout, "Table Load (us)", 1e6 * tablesLoadTime);
+	return true;
 }
 
+/*
+* Purpose: Map the precomputed tables PokerHandsTables wrote
+* Parameters: string path of the table file
+* Returns: bool - false if the file can not be mapped or is not a valid table file
+*/
+bool PokerHandsSerial::loadTables(const string& path) {
+	string error;
+	Stopwatch timer;
+	bool loaded = tables.open(path, error);
+	tablesLoadTime = timer.elapsed();
+	if (!loaded)
+		cerr << "Tables: " << error << endl;
+	return loaded;
+}
 
 /*
-* Purpose: Count the number of digits and add spaces in front of hands generated and frequency. 
-*		   This function is used for formatting the report.
-* Parameters: Int
-* Returns: None
+* Purpose: Open the results file the snapshots of the run are written to
+* Parameters: SimulationOptions with the name and format of the results file
+* Returns: bool - false if the file can not be opened
 */
-void PokerHandsSerial::printNumber(int num) {
-	for (int i = countDigits(num); i < 25; ++i)
-		cout << " ";
-	cout << num;
+bool PokerHandsSerial::openResults(const SimulationOptions& options) {
+	string error;
+	bool opened = results.open(options.resultsFile, options.resultFormat, 1, checkpoint.previousElapsed, error);
+	if (!opened)
+		cerr << "Results: " << error << endl;
+	return opened;
 }
 
 int main(int argc, char* argv[])
 {
-	PokerHandsSerial s;
-	cout << "            Poker Hand Frequency Simulation [Serial Version]\n";
-	cout << "================================================================================\n";
-	cout << "        Hand Type                Frequency       Relative Frequency (%)         \n";
-	cout << "--------------------------------------------------------------------------------\n";
+	SimulationOptions options;
+	if (!options.parse(argc, argv)) {
+		options.printUsage(argv[0]);
+		return 1;
+	}
+
+	// A resumed run carries on with the seed of the checkpoint and streams of its own
+	Checkpoint resumed;
+	string error;
+	if (options.resume && !(resumed.read(options.checkpointFile, error) && resumed.resume(options, error))) {
+		cerr << "Checkpoint: " << error << endl;
+		return 1;
+	}
+
+	PokerHandsSerial s(options, resumed);
+	if (!options.tablesFile.empty() && !s.loadTables(options.tablesFile))
+		return 1;
+	if (!options.resultsFile.empty() && !s.openResults(options))
+		return 1;
+	if (!options.equityFile.empty()) {
+		ReportFormatter::printTitle(cout, "Serial Version, Equity");
+		bool calculated = s.calculateEquity(options);
+		ReportFormatter::printRule(cout);
+		return calculated ? 0 : 1;
+	}
+	if (options.selfTest)
+		return s.selfTest(options.selfTestHands) ? 0 : 1;
+
+	string version = (options.cardsPerHand == 7) ? "Serial Version, 7 Cards" : "Serial Version";
+	if (options.exhaustive) {
+		ReportFormatter::printHeader(cout, (version + ", Exhaustive").c_str());
+		s.enumerateHands();
+		s.report();
+		bool exact = s.checkExact();
+		ReportFormatter::printRule(cout);
+		return exact ? 0 : 1;
+	}
+
+	if (options.multinomialHands > 0) {
+		ReportFormatter::printHeader(cout, (version + ", Multinomial").c_str());
+		s.sampleCounts(options.multinomialHands);
+		s.report();
+		bool valid = !options.validate || s.validateSampler(options.multinomialHands);
+		ReportFormatter::printRule(cout);
+		return valid ? 0 : 1;
+	}
+
+	ReportFormatter::printHeader(cout, version.c_str());
 	s.drawHands();
 	s.report();
-	cout << "--------------------------------------------------------------------------------";
+	ReportFormatter::printRule(cout);
 }
 
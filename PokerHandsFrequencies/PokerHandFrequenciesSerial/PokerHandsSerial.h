@@ -10,41 +10,76 @@
 *      the number of frequencies for each of the ten hand-types.
 */
 
-#include <map>
+#include <cstdint>
+#include <string>
+
+#include "../PokerHandsCore/Checkpoint.h"
+#include "../PokerHandsCore/HandCounts.h"
+#include "../PokerHandsCore/HandTables.h"
+#include "../PokerHandsCore/MultinomialSampler.h"
+#include "../PokerHandsCore/Random.h"
+#include "../PokerHandsCore/ResultsSink.h"
+#include "../PokerHandsCore/SimulationOptions.h"
+#include "../PokerHandsCore/StoppingRule.h"
+#include "../PokerHandsCore/WorkerPool.h"
 
 class PokerHandsSerial {
 public:
 
 	//Constructor/Deconstructor
-	PokerHandsSerial();
+	PokerHandsSerial(const SimulationOptions& options, const Checkpoint& resumed);
 	~PokerHandsSerial();
 
 	//Public Method	
 	void drawHands();	
+	void enumerateHands();
+	void sampleCounts(uint64_t numHands);
 	void report();
+	bool selfTest(int numHands);
+	bool validateSampler(uint64_t numHands);
+	bool checkExact();
+	bool calculateEquity(const SimulationOptions& options);
+	bool loadTables(const std::string& path);
+	bool openResults(const SimulationOptions& options);
 
 	// Public static method
-	static int getRandom(void);
 	static void printHand(int hand[5]);
-	static void printNumber(int num);
 
 private:
 	//Private Functions
-	void setUpDeck();
-	void randomizeDeck(int arr[], int n);
 	void countFrequencies();
+	void _drawUntilRule();
+	void _dealSplit(uint64_t numHands);
+	void _saveCheckpoint(const HandCounts& dealt, double elapsed);
 
 	//Member Variables
 	int cardIdx;
-	int deck[52];
-	int hand[5];
 	double duration;
-	std::map<std::string, int> frequencyMap;
-	std::map<std::string, int>::iterator it;
-
-	// Private static method
-	static bool _seeded;
-	static void _seedRNG(void);
+	WorkerPool pool;
+	StoppingRule rule;
+	StopReason stopReason;
+	// Hands a --hands run deals, split between the threads (0 when it is not one)
+	uint64_t numHands;
+	bool reproducible;
+	MultinomialSampler sampler;
+	bool multinomial;
+	// Precomputed tables, mapped from the --tables file
+	HandTables tables;
+	double tablesLoadTime;
+	bool fromTable;
+	// The checkpoint of the run, with the counts of the segments before this one when it was resumed
+	Checkpoint checkpoint;
+	std::string checkpointFile;
+	double checkpointSeconds;
+	int checkpoints;
+	double checkpointTime;
+	// Snapshots of the run written as it goes, see ResultsSink.h
+	ResultsSink results;
+	double snapshotSeconds;
+	RngType generator;
+	uint64_t seed;
+	int cardsPerHand;
+	HandCounts counts;
 };
 #endif;
 
@@ -0,0 +1,785 @@
+/*
+* Program: PokerHandsBenchmark
+* Module: PokerHandsBenchmark.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Microbenchmark that measures how many hands per second the table driven
+*      HandEvaluator classifies against the sort-and-scan classifier it replaced. Both
+*      classifiers are first checked against each other on every 5-card hand, as are the
+*      card mask classifier and the batch classifier with every instruction set this CPU
+*      supports, and the packed card encoding is checked for every card. The 7-card
+*      evaluator is checked against the best of the 21 5-card hands in each of a million
+*      7-card hands and timed against that brute force. It then times the whole per-hand
+*      loop (deal and classify) with each random number generator, and the multinomial
+*      engine that draws the counts of N hands without dealing them.
+*      With --stages it instead times each stage of the per-hand loop on its own (random
+*      numbers, the shuffle, the old sort, classifying, tallying) and the whole loop of the
+*      serial program's threads and of each parallel rank, as the median of repeated runs.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../PokerHandsCore/BatchClassifier.h"
+#include "../PokerHandsCore/Card.h"
+#include "../PokerHandsCore/HandEnumerator.h"
+#include "../PokerHandsCore/HandEvaluator.h"
+#include "../PokerHandsCore/HandWorker.h"
+#include "../PokerHandsCore/MultinomialSampler.h"
+#include "../PokerHandsCore/PhaseTimer.h"
+#include "../PokerHandsCore/Random.h"
+#include "../PokerHandsCore/SevenCardEvaluator.h"
+
+using namespace std;
+
+//Const
+const int BENCH_HANDS = 1 << 20;
+const int BENCH_PASSES = 20;
+const int SIMULATION_HANDS = 20000000;
+const int MULTINOMIAL_SAMPLES = 100000;
+const int SEVEN_CARD_HANDS = 1 << 20;
+// 7-card hands whose strengths are compared against the best of their 21 5-card hands
+const int STRENGTH_HANDS = 1 << 18;
+// Hands in each run of a stage, and runs of each stage unless --stages says how many
+const int STAGE_HANDS = 1 << 20;
+const int STAGE_REPETITIONS = 15;
+
+// The stages' checksums are added here and printed so the work they do is kept
+uint64_t stageChecksum = 0;
+
+/*
+* Purpose: Sort the hand of 5 cards to determine its suit and rank
+* Parameters: const int pointer to ls, rs
+* Returns:
+*/
+bool sort_cards(const int& ls, const int& rs) {
+	return ls % 13 < rs % 13;
+}
+
+/*
+* Purpose: The sort-and-scan classifier previously copied into drawHands, processSerial and
+*		   processSlave, kept here as the baseline to measure against
+* Parameters: Int array of 5 cards numbered 0 - 51
+* Returns: HandType
+*/
+HandType legacyClassify(const int cards[5]) {
+	int hand[5];
+	bool isPair = false, isTriple = false, isTwoPair = false, isFullHouse = false, isQuadruple = false, isRoyal = false;
+	bool isStraight = true, isFlush = true;
+	for (int i = 0; i < 5; ++i) {
+		hand[i] = cards[i];
+		if (hand[0] / 13 != hand[i] / 13) {
+			isFlush = false;
+		}
+	}
+	sort(hand, hand + 5, sort_cards);
+	if (!isFlush) {
+		for (int i = 0; i < 4;) {
+			int comp = hand[i] % 13;
+			for (int j = i + 1; j <= 5; ++j) {
+				if (j == 5 || comp != hand[j] % 13) {
+					if (j - i == 2) {
+						if (isPair) {
+							isTwoPair = true;
+						}
+						else if (isTriple) {
+							isFullHouse = true;
+						}
+						else {
+							isPair = true;
+						}
+					}
+					else if (j - i == 3) {
+						if (isPair) {
+							isFullHouse = true;
+						}
+						else {
+							isTriple = true;
+						}
+					}
+					else if (j - i == 4) {
+						isQuadruple = true;
+					}
+					i += j - i;
+					break;
+				}
+			}
+		}
+	}
+	if (!(isPair || isTwoPair || isTriple || isFullHouse || isQuadruple)) {
+		for (int i = 1; i < 5; ++i) {
+			if (hand[0] % 13 != (hand[i] - i) % 13) {
+				isStraight = false;
+				break;
+			}
+		}
+		if (hand[0] % 13 == 0 && hand[1] % 13 == 9) {
+			isRoyal = true;
+			isStraight = true;
+		}
+	}
+	if (isFullHouse) return FULL_HOUSE;
+	if (isTwoPair) return TWO_PAIR;
+	if (isTriple) return THREE_OF_A_KIND;
+	if (isPair) return ONE_PAIR;
+	if (isQuadruple) return FOUR_OF_A_KIND;
+	if (isRoyal && isFlush) return ROYAL_FLUSH;
+	if (isStraight && isFlush) return STRAIGHT_FLUSH;
+	if (isStraight) return STRAIGHT;
+	if (isFlush) return FLUSH;
+	return NO_PAIR;
+}
+
+/*
+* Purpose: Check both classifiers agree on all 2,598,960 hands
+* Parameters: HandEvaluator
+* Returns: Number of hands where they disagree
+*/
+int compareAllHands(const HandEvaluator& evaluator) {
+	int mismatches = 0;
+	int hand[5];
+	for (hand[0] = 0; hand[0] < 52; ++hand[0])
+		for (hand[1] = hand[0] + 1; hand[1] < 52; ++hand[1])
+			for (hand[2] = hand[1] + 1; hand[2] < 52; ++hand[2])
+				for (hand[3] = hand[2] + 1; hand[3] < 52; ++hand[3])
+					for (hand[4] = hand[3] + 1; hand[4] < 52; ++hand[4])
+						if (evaluator.classify(hand) != legacyClassify(hand))
+							++mismatches;
+	return mismatches;
+}
+
+/*
+* Purpose: Check the packed card of every card number 0 - 51 has the rank (number % 13) and suit
+*		   (number / 13) it should, converts back to its number and has a bit of its own inside its
+*		   suit's 13-bit field of a hand mask. Going through every card covers the suit boundaries
+*		   (12 and 13, 25 and 26, 38 and 39) where 1-based card numbers used to land in the wrong suit.
+* Parameters: None
+* Returns: Number of cards that are wrong
+*/
+int checkCardEncoding() {
+	int errors = 0;
+	HandMask deck = 0;
+	for (int index = 0; index < DECK_SIZE; ++index) {
+		Card card = cardFromIndex(index);
+		HandMask bit = cardMask(card);
+		int suit = index / RANKS_PER_SUIT;
+		bool correct = cardRank(card) == index % RANKS_PER_SUIT && cardSuit(card) == suit
+			&& cardIndex(card) == index && (deck & bit) == 0
+			&& suitRanks(bit, suit) == (1u << (index % RANKS_PER_SUIT));
+		for (int other = 0; other < 4; ++other)
+			if (other != suit && suitRanks(bit, other) != 0)
+				correct = false;
+		if (!correct)
+			++errors;
+		deck |= bit;
+	}
+	for (int suit = 0; suit < 4; ++suit)
+		if (suitRanks(deck, suit) != SUIT_RANKS)
+			++errors;
+	return errors;
+}
+
+/*
+* Purpose: Check the card mask classifier gives the same hand-type as HandEvaluator::classify on all
+*		   2,598,960 hands
+* Parameters: HandEvaluator
+* Returns: Number of hands where they disagree
+*/
+int compareMask(const HandEvaluator& evaluator) {
+	int mismatches = 0;
+	int hand[5];
+	HandEnumerator::unrank(0, hand);
+	for (uint64_t index = 0; index < 2598960; ++index) {
+		HandMask mask = 0;
+		for (int i = 0; i < 5; ++i)
+			mask |= cardMask(cardFromIndex(hand[i]));
+		if (evaluator.classifyMask(mask) != evaluator.classify(hand))
+			++mismatches;
+		HandEnumerator::next(hand);
+	}
+	return mismatches;
+}
+
+/*
+* Purpose: Check the batch classifier gives the same hand-type as HandEvaluator::classify on all
+*		   2,598,960 hands, with one instruction set
+* Parameters: HandEvaluator, BatchClassifier set to the instruction set
+* Returns: Number of hands where they disagree
+*/
+int compareBatch(const HandEvaluator& evaluator, const BatchClassifier& classifier) {
+	int mismatches = 0;
+	int hand[5];
+	HandBatch batch;
+	HandEnumerator::unrank(0, hand);
+	for (uint64_t index = 0; index < 2598960; index += batch.size) {
+		batch.size = (int)min<uint64_t>(HandBatch::SIZE, 2598960 - index);
+		int first[5] = { hand[0], hand[1], hand[2], hand[3], hand[4] };
+		for (int i = 0; i < batch.size; ++i) {
+			batch.set(i, hand);
+			HandEnumerator::next(hand);
+		}
+		classifier.classify(batch);
+
+		for (int i = 0; i < batch.size; ++i) {
+			if (batch.types[i] != evaluator.classify(first))
+				++mismatches;
+			HandEnumerator::next(first);
+		}
+	}
+	return mismatches;
+}
+
+/*
+* Purpose: Time the batch classifier over the dealt hands and print its throughput
+* Parameters: BatchClassifier, dealt hands
+* Returns: Hands classified per second
+*/
+double timeBatch(const BatchClassifier& classifier, const vector<int>& hands) {
+	// Copy the hands into batches first so only classifying is timed
+	int count = (int)hands.size() / 5;
+	vector<HandBatch> batches(count / HandBatch::SIZE);
+	for (size_t b = 0; b < batches.size(); ++b) {
+		batches[b].size = HandBatch::SIZE;
+		for (int i = 0; i < HandBatch::SIZE; ++i)
+			batches[b].set(i, &hands[(b * HandBatch::SIZE + i) * 5]);
+	}
+
+	unsigned long long checksum = 0;
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+	for (int pass = 0; pass < BENCH_PASSES; ++pass) {
+		for (size_t b = 0; b < batches.size(); ++b) {
+			classifier.classify(batches[b]);
+			checksum += batches[b].types[b % HandBatch::SIZE];
+		}
+	}
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - begin;
+
+	double handsPerSecond = (double)batches.size() * HandBatch::SIZE * BENCH_PASSES / elapsed.count();
+	string label = string("batch ") + BatchClassifier::levelName(classifier.level());
+	cout << setw(20) << label << setw(20) << fixed << setprecision(0) << handsPerSecond
+		<< setw(16) << setprecision(2) << 1e9 / handsPerSecond << "   (checksum " << checksum << ")\n";
+	return handsPerSecond;
+}
+
+/*
+* Purpose: Deal random hands into a flat array so dealing is not part of the timing
+* Parameters: Int vector to fill, number of hands, number of cards per hand
+* Returns: None
+*/
+void dealHands(vector<int>& hands, int count, int numCards = 5) {
+	int deck[52];
+	for (int i = 0; i < 52; ++i)
+		deck[i] = i;
+	srand(12345);
+	hands.resize(count * numCards);
+	for (int h = 0; h < count; ++h) {
+		for (int i = 0; i < numCards; ++i) {
+			int j = i + rand() % (52 - i);
+			swap(deck[i], deck[j]);
+			hands[h * numCards + i] = deck[i];
+		}
+	}
+}
+
+/*
+* Purpose: The best hand-type of the 21 5-card hands in a 7-card hand, by classifying each of them
+* Parameters: HandEvaluator, Int array of 7 cards numbered 0 - 51
+* Returns: HandType
+*/
+HandType bestOfTwentyOne(const HandEvaluator& evaluator, const int* cards) {
+	HandType best = NO_PAIR;
+	int hand[5];
+	// Leave out two of the seven cards
+	for (int skip1 = 0; skip1 < 7; ++skip1) {
+		for (int skip2 = skip1 + 1; skip2 < 7; ++skip2) {
+			int n = 0;
+			for (int i = 0; i < 7; ++i)
+				if (i != skip1 && i != skip2)
+					hand[n++] = cards[i];
+			best = max(best, evaluator.classify(hand));
+		}
+	}
+	return best;
+}
+
+/*
+* Purpose: Get the card mask of a hand of 7 cards numbered 0 - 51
+* Parameters: Int array of 7 cards
+* Returns: HandMask
+*/
+HandMask sevenCardMask(const int* cards) {
+	HandMask mask = 0;
+	for (int i = 0; i < 7; ++i)
+		mask |= cardMask(cardFromIndex(cards[i]));
+	return mask;
+}
+
+/*
+* Purpose: Check the 7-card evaluator against the best of the 21 5-card hands on dealt 7-card hands
+* Parameters: HandEvaluator, SevenCardEvaluator, dealt 7-card hands
+* Returns: Number of hands where they disagree
+*/
+int compareSevenCard(const HandEvaluator& evaluator, const SevenCardEvaluator& sevenCardEvaluator, const vector<int>& hands) {
+	int mismatches = 0;
+	int count = (int)hands.size() / 7;
+	for (int h = 0; h < count; ++h)
+		if (sevenCardEvaluator.classify(sevenCardMask(&hands[h * 7])) != bestOfTwentyOne(evaluator, &hands[h * 7]))
+			++mismatches;
+	return mismatches;
+}
+
+/*
+* Purpose: The strength of a 5-card hand by sorting: the hand-type, then the ranks (ace high) ordered by
+*		   how many of each the hand holds and then by rank, so pairs come before kickers. A straight is
+*		   only its top card, the 5 for A, 2, 3, 4, 5.
+* Parameters: HandEvaluator, Int array of 5 cards numbered 0 - 51
+* Returns: A number that is larger for a stronger hand
+*/
+uint64_t referenceStrength(const HandEvaluator& evaluator, const int cards[5]) {
+	int held[13] = { 0 };
+	for (int i = 0; i < 5; ++i)
+		++held[(cards[i] % 13 + 12) % 13];
+	vector<pair<int, int> > ranks;
+	for (int value = 0; value < 13; ++value)
+		if (held[value])
+			ranks.push_back(make_pair(held[value], value));
+	sort(ranks.rbegin(), ranks.rend());
+
+	HandType type = evaluator.classify(cards);
+	uint64_t strength = type;
+	if (type == STRAIGHT || type == STRAIGHT_FLUSH || type == ROYAL_FLUSH) {
+		bool wheel = (ranks[0].second == 12 && ranks[1].second == 3);
+		ranks.assign(1, make_pair(1, wheel ? 3 : ranks[0].second));
+	}
+	for (int i = 0; i < 5; ++i)
+		strength = strength * 13 + (i < (int)ranks.size() ? ranks[i].second : 0);
+	return strength;
+}
+
+/*
+* Purpose: Check SevenCardEvaluator::strength orders dealt 7-card hands the same way as the best of their 21
+*		   5-card hands by referenceStrength, comparing each hand with the next, and has the right hand-type
+* Parameters: HandEvaluator, SevenCardEvaluator, dealt 7-card hands
+* Returns: Number of pairs of hands where they disagree
+*/
+int compareStrength(const HandEvaluator& evaluator, const SevenCardEvaluator& sevenCardEvaluator, const vector<int>& hands) {
+	vector<uint64_t> reference(STRENGTH_HANDS);
+	vector<HandStrength> strengths(STRENGTH_HANDS);
+	for (int h = 0; h < STRENGTH_HANDS; ++h) {
+		const int* cards = &hands[h * 7];
+		int hand[5];
+		for (int skip1 = 0; skip1 < 7; ++skip1) {
+			for (int skip2 = skip1 + 1; skip2 < 7; ++skip2) {
+				int n = 0;
+				for (int i = 0; i < 7; ++i)
+					if (i != skip1 && i != skip2)
+						hand[n++] = cards[i];
+				reference[h] = max(reference[h], referenceStrength(evaluator, hand));
+			}
+		}
+		strengths[h] = sevenCardEvaluator.strength(sevenCardMask(cards));
+	}
+
+	int mismatches = 0;
+	for (int h = 0; h + 1 < STRENGTH_HANDS; ++h) {
+		bool sameOrder = (reference[h] < reference[h + 1]) == (strengths[h] < strengths[h + 1])
+			&& (reference[h] == reference[h + 1]) == (strengths[h] == strengths[h + 1]);
+		bool sameType = SevenCardEvaluator::strengthType(strengths[h]) == sevenCardEvaluator.classify(sevenCardMask(&hands[h * 7]));
+		if (!sameOrder || !sameType)
+			++mismatches;
+	}
+	return mismatches;
+}
+
+/*
+* Purpose: Time the 7-card evaluator and the best of 21 brute force over the dealt 7-card hands and print their throughput
+* Parameters: HandEvaluator, SevenCardEvaluator, dealt 7-card hands
+* Returns: How many times faster the 7-card evaluator is
+*/
+double timeSevenCard(const HandEvaluator& evaluator, const SevenCardEvaluator& sevenCardEvaluator, const vector<int>& hands) {
+	int count = (int)hands.size() / 7;
+	vector<HandMask> masks(count);
+	for (int h = 0; h < count; ++h)
+		masks[h] = sevenCardMask(&hands[h * 7]);
+
+	unsigned long long checksum = 0;
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+	for (int h = 0; h < count; ++h)
+		checksum += bestOfTwentyOne(evaluator, &hands[h * 7]);
+	chrono::duration<double> bruteForce = chrono::steady_clock::now() - begin;
+	double bruteRate = count / bruteForce.count();
+	cout << setw(20) << "best of 21" << setw(20) << fixed << setprecision(0) << bruteRate
+		<< setw(16) << setprecision(2) << 1e9 / bruteRate << "   (checksum " << checksum << ")\n";
+
+	checksum = 0;
+	begin = chrono::steady_clock::now();
+	for (int pass = 0; pass < BENCH_PASSES; ++pass)
+		for (int h = 0; h < count; ++h)
+			checksum += sevenCardEvaluator.classify(masks[h]);
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - begin;
+	double rate = (double)count * BENCH_PASSES / elapsed.count();
+	cout << setw(20) << "7-card masks" << setw(20) << fixed << setprecision(0) << rate
+		<< setw(16) << setprecision(2) << 1e9 / rate << "   (checksum " << checksum / BENCH_PASSES << ")\n";
+	return rate / bruteRate;
+}
+
+/*
+* Purpose: Time a classifier over the dealt hands and print its throughput
+* Parameters: Label, classifier callable, dealt hands
+* Returns: Hands classified per second
+*/
+template <typename Classifier>
+double timeClassifier(const char* label, Classifier classify, const vector<int>& hands) {
+	int count = (int)hands.size() / 5;
+	unsigned long long checksum = 0;
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+	for (int pass = 0; pass < BENCH_PASSES; ++pass)
+		for (int h = 0; h < count; ++h)
+			checksum += classify(&hands[h * 5]);
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - begin;
+
+	double handsPerSecond = (double)count * BENCH_PASSES / elapsed.count();
+	cout << setw(20) << label << setw(20) << fixed << setprecision(0) << handsPerSecond
+		<< setw(16) << setprecision(2) << 1e9 / handsPerSecond << "   (checksum " << checksum << ")\n";
+	return handsPerSecond;
+}
+
+/*
+* Purpose: Time the card mask classifier over the dealt hands and print its throughput
+* Parameters: HandEvaluator, dealt hands
+* Returns: Hands classified per second
+*/
+double timeMasks(const HandEvaluator& evaluator, const vector<int>& hands) {
+	// Make the masks first so only classifying is timed
+	int count = (int)hands.size() / 5;
+	vector<HandMask> masks(count);
+	for (int h = 0; h < count; ++h)
+		for (int i = 0; i < 5; ++i)
+			masks[h] |= cardMask(cardFromIndex(hands[h * 5 + i]));
+
+	unsigned long long checksum = 0;
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+	for (int pass = 0; pass < BENCH_PASSES; ++pass)
+		for (int h = 0; h < count; ++h)
+			checksum += evaluator.classifyMask(masks[h]);
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - begin;
+
+	double handsPerSecond = (double)count * BENCH_PASSES / elapsed.count();
+	cout << setw(20) << "card mask" << setw(20) << fixed << setprecision(0) << handsPerSecond
+		<< setw(16) << setprecision(2) << 1e9 / handsPerSecond << "   (checksum " << checksum << ")\n";
+	return handsPerSecond;
+}
+
+/*
+* Purpose: rand() with the rejection getRandom used before the generators were added, kept as
+*		   the baseline to measure them against
+* Parameters: Int bound
+* Returns: A random int between 0 and bound - 1
+*/
+int randBelow(int bound) {
+	const unsigned range = (unsigned)RAND_MAX + 1;
+	const unsigned limit = range - range % bound;
+	unsigned value;
+	do {
+		value = (unsigned)rand();
+	} while (value >= limit);
+	return value % bound;
+}
+
+/*
+* Purpose: Time the simulation loop, dealing 5 cards with a partial Fisher-Yates shuffle and
+*		   classifying them, with a source of bounded random numbers
+* Parameters: Label, bounded random callable, HandEvaluator
+* Returns: Hands simulated per second
+*/
+template <typename RandomBelow>
+double timeSimulation(const char* label, RandomBelow randomBelow, const HandEvaluator& evaluator) {
+	int deck[52], hand[5];
+	for (int i = 0; i < 52; ++i)
+		deck[i] = i;
+	unsigned long long counts[NUM_HAND_TYPES] = { 0 };
+
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+	for (int n = 0; n < SIMULATION_HANDS; ++n) {
+		for (int i = 0; i < 5; ++i) {
+			int j = i + randomBelow(52 - i);
+			swap(deck[i], deck[j]);
+			hand[i] = deck[i];
+		}
+		++counts[evaluator.classify(hand)];
+	}
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - begin;
+
+	double handsPerSecond = SIMULATION_HANDS / elapsed.count();
+	cout << setw(20) << label << setw(20) << fixed << setprecision(0) << handsPerSecond
+		<< setw(16) << setprecision(2) << 1e9 / handsPerSecond << "   (royal flushes " << counts[ROYAL_FLUSH] << ")\n";
+	return handsPerSecond;
+}
+
+/*
+* Purpose: Time drawing the hand-type counts of a number of hands from the multinomial. The cost
+*		   barely depends on the number of hands, so it is shown per sample rather than per hand.
+* Parameters: MultinomialSampler, uint64_t hands per sample
+* Returns: Microseconds per sample
+*/
+double timeMultinomial(MultinomialSampler& sampler, uint64_t numHands) {
+	uint64_t royalFlushes = 0;
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+	for (int n = 0; n < MULTINOMIAL_SAMPLES; ++n)
+		royalFlushes += sampler.sample(numHands)[ROYAL_FLUSH];
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - begin;
+
+	double microseconds = 1e6 * elapsed.count() / MULTINOMIAL_SAMPLES;
+	cout << setw(20) << numHands << setw(20) << fixed << setprecision(3) << microseconds
+		<< "   (royal flushes / sample " << royalFlushes / MULTINOMIAL_SAMPLES << ")\n";
+	return microseconds;
+}
+
+/*
+* Purpose: Time one stage of the per-hand loop a number of times and print the median time per hand
+*		   with its spread. The first run warms the caches and the branch predictors and is not
+*		   counted.
+* Parameters: Label, Int hands per run, Int number of runs, stage callable that handles that many
+*			  hands and returns a checksum so the work can not be optimized away
+* Returns: Median hands per second
+*/
+template <typename Stage>
+double timeStage(const char* label, int hands, int repetitions, Stage stage) {
+	stageChecksum += stage();
+	vector<double> nanoseconds(repetitions);
+	for (int rep = 0; rep < repetitions; ++rep) {
+		Stopwatch timer;
+		stageChecksum += stage();
+		nanoseconds[rep] = 1e9 * timer.elapsed() / hands;
+	}
+
+	double mean = 0, variance = 0;
+	for (int rep = 0; rep < repetitions; ++rep)
+		mean += nanoseconds[rep] / repetitions;
+	for (int rep = 0; rep < repetitions; ++rep)
+		variance += (nanoseconds[rep] - mean) * (nanoseconds[rep] - mean) / max(repetitions - 1, 1);
+	sort(nanoseconds.begin(), nanoseconds.end());
+	double median = (repetitions % 2 == 1) ? nanoseconds[repetitions / 2]
+		: (nanoseconds[repetitions / 2 - 1] + nanoseconds[repetitions / 2]) / 2;
+
+	cout << setw(22) << label << setw(12) << fixed << setprecision(2) << median
+		<< setw(10) << sqrt(variance) << setw(10) << nanoseconds[0]
+		<< setw(16) << setprecision(0) << 1e9 / median << "\n";
+	return 1e9 / median;
+}
+
+/*
+* Purpose: Time each stage of dealing and counting a hand on its own (drawing random numbers,
+*		   shuffling the deck, the sort of the old classifier, classifying and tallying), then the
+*		   whole per-hand loop the way the serial program's threads deal a number of hands, the
+*		   way each rank of the parallel program deals its batches and the way a --reproducible
+*		   run deals each hand from its index. Runs without MPI.
+* Parameters: HandEvaluator, BatchClassifier at its fastest level, Int number of runs of each stage
+* Returns: None
+*/
+void timeStages(const HandEvaluator& evaluator, const BatchClassifier& classifier, int repetitions) {
+	vector<int> hands;
+	dealHands(hands, STAGE_HANDS);
+	vector<unsigned char> types(STAGE_HANDS);
+	for (int h = 0; h < STAGE_HANDS; ++h)
+		types[h] = (unsigned char)evaluator.classify(&hands[h * 5]);
+	vector<HandBatch> batches(STAGE_HANDS / HandBatch::SIZE);
+	for (size_t b = 0; b < batches.size(); ++b) {
+		batches[b].size = HandBatch::SIZE;
+		for (int i = 0; i < HandBatch::SIZE; ++i)
+			batches[b].set(i, &hands[(b * HandBatch::SIZE + i) * 5]);
+	}
+
+	SimulationOptions options;
+	options.seed = 12345;
+	RandomStream random;
+	random.seed(options.generator, options.seed);
+	Card deck[DECK_SIZE];
+	for (int i = 0; i < DECK_SIZE; ++i)
+		deck[i] = cardFromIndex(i);
+
+	cout << "Stage timings: median of " << repetitions << " runs of " << STAGE_HANDS << " hands, "
+		<< RandomStream::typeName(options.generator) << " generator\n";
+	cout << "                 Stage   ns / hand    +/- ns    min ns     Hands / sec\n";
+	cout << "------------------------------------------------------------------------\n";
+	// A hand draws one bounded number per card
+	timeStage("RNG draw (5 / hand)", STAGE_HANDS, repetitions, [&random]() {
+		uint64_t sum = 0;
+		for (int h = 0; h < STAGE_HANDS; ++h)
+			for (int i = 0; i < 5; ++i)
+				sum += random.nextBelow(DECK_SIZE - i);
+		return sum;
+	});
+	timeStage("deal (Fisher-Yates)", STAGE_HANDS, repetitions, [&random, &deck]() {
+		uint64_t sum = 0;
+		for (int h = 0; h < STAGE_HANDS; ++h) {
+			for (int i = 0; i < 5; ++i) {
+				int j = i + random.nextBelow(DECK_SIZE - i);
+				swap(deck[i], deck[j]);
+			}
+			sum += deck[h % 5];
+		}
+		return sum;
+	});
+	timeStage("sort_cards sort", STAGE_HANDS, repetitions, [&hands]() {
+		uint64_t sum = 0;
+		int hand[5];
+		for (int h = 0; h < STAGE_HANDS; ++h) {
+			copy(&hands[h * 5], &hands[h * 5] + 5, hand);
+			sort(hand, hand + 5, sort_cards);
+			sum += hand[0];
+		}
+		return sum;
+	});
+	timeStage("classify (table)", STAGE_HANDS, repetitions, [&evaluator, &hands]() {
+		uint64_t sum = 0;
+		for (int h = 0; h < STAGE_HANDS; ++h)
+			sum += evaluator.classify(&hands[h * 5]);
+		return sum;
+	});
+	string batchLabel = string("classify (") + BatchClassifier::levelName(classifier.level()) + ")";
+	timeStage(batchLabel.c_str(), STAGE_HANDS, repetitions, [&classifier, &batches]() {
+		uint64_t sum = 0;
+		for (size_t b = 0; b < batches.size(); ++b) {
+			classifier.classify(batches[b]);
+			sum += batches[b].types[b % HandBatch::SIZE];
+		}
+		return sum;
+	});
+	timeStage("counter increment", STAGE_HANDS, repetitions, [&types]() {
+		HandCounts counts;
+		for (int h = 0; h < STAGE_HANDS; ++h)
+			++counts[(HandType)types[h]];
+		return counts[ROYAL_FLUSH];
+	});
+	cout << "------------------------------------------------------------------------\n";
+
+	// The whole loop, through the worker the programs deal with
+	HandWorker serialWorker(options, 0, 0);
+	timeStage("serial loop", STAGE_HANDS, repetitions, [&serialWorker]() {
+		serialWorker.drawHands(STAGE_HANDS);
+		return serialWorker.counts()[ROYAL_FLUSH];
+	});
+	HandWorker rankWorker(options, 1, 0);
+	atomic<unsigned> typesSeen(0);
+	timeStage("rank loop (batches)", STAGE_HANDS, repetitions, [&rankWorker, &typesSeen]() {
+		for (int b = 0; b < STAGE_HANDS / HandBatch::SIZE; ++b)
+			rankWorker.drawBatch(typesSeen);
+		return rankWorker.counts()[ROYAL_FLUSH];
+	});
+	// A --reproducible run deals each hand from its own index instead of the thread's stream
+	options.reproducible = true;
+	HandWorker indexedWorker(options, 0, 0);
+	uint64_t nextHand = 0;
+	timeStage("by hand index loop", STAGE_HANDS, repetitions, [&indexedWorker, &nextHand]() {
+		indexedWorker.drawRange(nextHand, nextHand + STAGE_HANDS);
+		nextHand += STAGE_HANDS;
+		return indexedWorker.counts()[ROYAL_FLUSH];
+	});
+	cout << "------------------------------------------------------------------------\n";
+	cout << "(checksum " << stageChecksum << ")\n";
+}
+
+int main(int argc, char* argv[])
+{
+	int repetitions = 0;
+	for (int i = 1; i < argc; ++i) {
+		if (string(argv[i]) == "--stages") {
+			repetitions = STAGE_REPETITIONS;
+			if (i + 1 < argc && atoi(argv[i + 1]) > 0)
+				repetitions = atoi(argv[++i]);
+		}
+		else {
+			cout << "Usage: " << argv[0] << " [--stages [repetitions]]\n";
+			return 1;
+		}
+	}
+
+	HandEvaluator evaluator;
+	if (repetitions > 0) {
+		BatchClassifier fastestClassifier;
+		timeStages(evaluator, fastestClassifier, repetitions);
+		return 0;
+	}
+
+	int mismatches = compareAllHands(evaluator);
+	cout << "Classifier mismatches over all 2598960 hands: " << mismatches << "\n";
+
+	int cardErrors = checkCardEncoding();
+	cout << "Card encoding errors over all 52 cards: " << cardErrors << "\n";
+	mismatches += cardErrors;
+
+	int maskMismatches = compareMask(evaluator);
+	cout << "Card mask classifier mismatches: " << maskMismatches << "\n";
+	mismatches += maskMismatches;
+
+	BatchClassifier classifier;
+	SimdLevel fastest = classifier.level();
+	for (int level = SIMD_SCALAR; level <= fastest; ++level) {
+		classifier.setLevel((SimdLevel)level);
+		int batchMismatches = compareBatch(evaluator, classifier);
+		cout << "Batch classifier (" << BatchClassifier::levelName((SimdLevel)level) << ") mismatches: " << batchMismatches << "\n";
+		mismatches += batchMismatches;
+	}
+
+	SevenCardEvaluator sevenCardEvaluator;
+	vector<int> sevenCardHands;
+	dealHands(sevenCardHands, SEVEN_CARD_HANDS, 7);
+	int sevenCardMismatches = compareSevenCard(evaluator, sevenCardEvaluator, sevenCardHands);
+	cout << "7-card evaluator mismatches over " << SEVEN_CARD_HANDS << " hands: " << sevenCardMismatches << "\n";
+	mismatches += sevenCardMismatches;
+	int strengthMismatches = compareStrength(evaluator, sevenCardEvaluator, sevenCardHands);
+	cout << "7-card strength mismatches over " << STRENGTH_HANDS << " hands: " << strengthMismatches << "\n";
+	mismatches += strengthMismatches;
+	cout << "\n";
+
+	vector<int> hands;
+	dealHands(hands, BENCH_HANDS);
+
+	cout << "          Classifier         Hands / sec      ns / hand\n";
+	cout << "--------------------------------------------------------\n";
+	double legacy = timeClassifier("sort-and-scan", legacyClassify, hands);
+	double table = timeClassifier("table", [&evaluator](const int* hand) { return evaluator.classify(hand); }, hands);
+	timeMasks(evaluator, hands);
+	for (int level = SIMD_SCALAR; level <= fastest; ++level) {
+		classifier.setLevel((SimdLevel)level);
+		timeBatch(classifier, hands);
+	}
+	cout << "--------------------------------------------------------\n";
+	cout << "Speedup: " << setprecision(2) << table / legacy << "x\n\n";
+
+	cout << "   7-card Classifier         Hands / sec      ns / hand\n";
+	cout << "--------------------------------------------------------\n";
+	double sevenCardSpeedup = timeSevenCard(evaluator, sevenCardEvaluator, sevenCardHands);
+	cout << "--------------------------------------------------------\n";
+	cout << "Speedup: " << setprecision(2) << sevenCardSpeedup << "x\n\n";
+
+	cout << "     Simulation loop         Hands / sec      ns / hand\n";
+	cout << "--------------------------------------------------------\n";
+	srand(12345);
+	timeSimulation("rand()", randBelow, evaluator);
+	for (int type = 0; type < NUM_RNG_TYPES; ++type) {
+		RandomStream random;
+		random.seed((RngType)type, 12345);
+		timeSimulation(RandomStream::typeName((RngType)type), [&random](int bound) { return random.nextBelow(bound); }, evaluator);
+	}
+	cout << "--------------------------------------------------------\n\n";
+
+	SimulationOptions options;
+	options.seed = 12345;
+	MultinomialSampler sampler(options, 0);
+	cout << "  Multinomial, hands           us / sample\n";
+	cout << "--------------------------------------------------------\n";
+	for (uint64_t numHands = 1000; numHands <= 1000000000000ULL; numHands *= 1000)
+		timeMultinomial(sampler, numHands);
+	cout << "--------------------------------------------------------\n";
+
+	return mismatches == 0 ? 0 : 1;
+}
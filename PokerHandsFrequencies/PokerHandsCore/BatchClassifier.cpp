@@ -0,0 +1,271 @@
+/*
+* Program: PokerHandFrequencies
+* Module: BatchClassifier.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Classifies a batch of 5-card hands at once. See BatchClassifier.h.
+*/
+
+#include <cstdint>
+
+#include "BatchClassifier.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define BATCH_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TARGET_AVX2
+#define TARGET_AVX512
+#else
+#include <cpuid.h>
+// Only these functions are compiled for AVX2 and AVX-512, the rest of the program runs anywhere
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+// Visual Studio 2013 has no AVX-512 intrinsics
+#if !defined(_MSC_VER) || _MSC_VER >= 1910
+#define BATCH_AVX512
+#endif
+#endif
+
+//Constructor
+BatchClassifier::BatchClassifier(){
+	_level = detectLevel();
+}
+
+//Deconstructor
+BatchClassifier::~BatchClassifier(){
+}
+
+#if defined(BATCH_X86)
+/*
+* Purpose: Read the cpuid registers for a leaf
+* Parameters: Int leaf, Int subleaf, unsigned array of 4 set to eax, ebx, ecx and edx
+* Returns: None
+*/
+static void readCpuid(int leaf, int subleaf, unsigned regs[4]) {
+#if defined(_MSC_VER)
+	__cpuidex((int*)regs, leaf, subleaf);
+#else
+	__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+/*
+* Purpose: Read the register state the operating system saves on a context switch (XCR0)
+* Parameters: None
+* Returns: uint64_t
+*/
+static uint64_t readXcr0() {
+#if defined(_MSC_VER)
+	return _xgetbv(0);
+#else
+	unsigned low, high;
+	__asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+	return ((uint64_t)high << 32) | low;
+#endif
+}
+
+/*
+* Purpose: Classify the hands of a batch 8 at a time with AVX2, up to the last full group of 8
+* Parameters: HandBatch, hand table of HandEvaluator
+* Returns: Int - the number of hands classified
+*/
+TARGET_AVX2 static int classifyAvx2(HandBatch& batch, const unsigned char(*handTable)[4]) {
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i one = _mm256_set1_epi32(1);
+	const __m256i rankField = _mm256_set1_epi32(0xF);
+	// Moves the low byte of each of the 8 results into the first 8 bytes
+	const __m256i packBytes = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m256i packLanes = _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0);
+
+	int i = 0;
+	for (; i + 8 <= batch.size; i += 8) {
+		__m256i ones = zero, twos = zero, fours = zero, ranks = zero;
+		__m256i suits = _mm256_set1_epi32(-1);
+
+		for (int c = 0; c < 5; ++c) {
+			// The rank bit (bits 0 - 12) and suit bit (bits 0 - 3) of each card
+			__m256i card = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)&batch.cards[c][i]));
+			__m256i rank = _mm256_sllv_epi32(one, _mm256_and_si256(card, rankField));
+			__m256i suit = _mm256_sllv_epi32(one, _mm256_srli_epi32(card, SUIT_SHIFT));
+
+			// Add one to the bit sliced count of the card's rank
+			__m256i carry = _mm256_and_si256(ones, rank);
+			ones = _mm256_xor_si256(ones, rank);
+			fours = _mm256_or_si256(fours, _mm256_and_si256(twos, carry));
+			twos = _mm256_xor_si256(twos, carry);
+
+			ranks = _mm256_or_si256(ranks, rank);
+			suits = _mm256_and_si256(suits, suit);
+		}
+
+		// The column of the hand table as a shift of 0, 8, 16 or 24 bits into its row.
+		// A count of 3 is the only one with both its ones and twos bits set.
+		__m256i hasTrips = _mm256_cmpeq_epi32(_mm256_and_si256(ones, twos), zero);
+		__m256i hasQuads = _mm256_cmpeq_epi32(fours, zero);
+		__m256i hasFlush = _mm256_cmpeq_epi32(suits, zero);
+		__m256i shift = _mm256_andnot_si256(hasTrips, _mm256_set1_epi32(8));
+		shift = _mm256_or_si256(shift, _mm256_andnot_si256(hasQuads, _mm256_set1_epi32(16)));
+		shift = _mm256_or_si256(shift, _mm256_andnot_si256(hasFlush, _mm256_set1_epi32(24)));
+
+		__m256i row = _mm256_i32gather_epi32((const int*)handTable, ranks, 4);
+		__m256i types = _mm256_shuffle_epi8(_mm256_srlv_epi32(row, shift), packBytes);
+		types = _mm256_permutevar8x32_epi32(types, packLanes);
+		_mm_storel_epi64((__m128i*)&batch.types[i], _mm256_castsi256_si128(types));
+	}
+	return i;
+}
+
+#if defined(BATCH_AVX512)
+/*
+* Purpose: Classify the hands of a batch 16 at a time with AVX-512, up to the last full group of 16
+* Parameters: HandBatch, hand table of HandEvaluator
+* Returns: Int - the number of hands classified
+*/
+TARGET_AVX512 static int classifyAvx512(HandBatch& batch, const unsigned char(*handTable)[4]) {
+	const __m512i zero = _mm512_setzero_si512();
+	const __m512i one = _mm512_set1_epi32(1);
+	const __m512i rankField = _mm512_set1_epi32(0xF);
+
+	int i = 0;
+	for (; i + 16 <= batch.size; i += 16) {
+		__m512i ones = zero, twos = zero, fours = zero, ranks = zero;
+		__m512i suits = _mm512_set1_epi32(-1);
+
+		for (int c = 0; c < 5; ++c) {
+			// The zero masked forms, the plain ones read an undefined register that GCC warns about
+			// The rank bit (bits 0 - 12) and suit bit (bits 0 - 3) of each card
+			__m512i card = _mm512_maskz_cvtepu8_epi32(0xFFFF, _mm_loadu_si128((const __m128i*)&batch.cards[c][i]));
+			__m512i rank = _mm512_maskz_sllv_epi32(0xFFFF, one, _mm512_and_si512(card, rankField));
+			__m512i suit = _mm512_maskz_sllv_epi32(0xFFFF, one, _mm512_maskz_srli_epi32(0xFFFF, card, SUIT_SHIFT));
+
+			// Add one to the bit sliced count of the card's rank
+			__m512i carry = _mm512_and_si512(ones, rank);
+			ones = _mm512_xor_si512(ones, rank);
+			fours = _mm512_or_si512(fours, _mm512_and_si512(twos, carry));
+			twos = _mm512_xor_si512(twos, carry);
+
+			ranks = _mm512_or_si512(ranks, rank);
+			suits = _mm512_and_si512(suits, suit);
+		}
+
+		// The column of the hand table as a shift of 0, 8, 16 or 24 bits into its row
+		__mmask16 hasTrips = _mm512_test_epi32_mask(ones, twos);
+		__mmask16 hasQuads = _mm512_test_epi32_mask(fours, fours);
+		__mmask16 hasFlush = _mm512_test_epi32_mask(suits, suits);
+		__m512i shift = _mm512_maskz_mov_epi32(hasTrips, _mm512_set1_epi32(8));
+		shift = _mm512_mask_mov_epi32(shift, hasQuads, _mm512_set1_epi32(16));
+		shift = _mm512_mask_mov_epi32(shift, hasFlush, _mm512_set1_epi32(24));
+
+		__m512i row = _mm512_mask_i32gather_epi32(zero, 0xFFFF, ranks, (const int*)handTable, 4);
+		_mm_storeu_si128((__m128i*)&batch.types[i], _mm512_maskz_cvtepi32_epi8(0xFFFF, _mm512_maskz_srlv_epi32(0xFFFF, row, shift)));
+	}
+	return i;
+}
+#endif
+#endif
+
+/*
+* Purpose: Find the fastest instruction set this CPU and operating system support
+* Parameters: None
+* Returns: SimdLevel
+*/
+SimdLevel BatchClassifier::detectLevel() {
+#if defined(BATCH_X86)
+	unsigned regs[4];
+	readCpuid(0, 0, regs);
+	if (regs[0] < 7)
+		return SIMD_SCALAR;
+
+	// AVX needs both the CPU flag and the operating system saving the YMM registers
+	readCpuid(1, 0, regs);
+	bool osxsave = (regs[2] & (1u << 27)) != 0;
+	bool avx = (regs[2] & (1u << 28)) != 0;
+	if (!osxsave || !avx)
+		return SIMD_SCALAR;
+	uint64_t xcr0 = readXcr0();
+	if ((xcr0 & 0x6) != 0x6)
+		return SIMD_SCALAR;
+
+	readCpuid(7, 0, regs);
+#if defined(BATCH_AVX512)
+	// AVX-512 also needs the opmask and ZMM registers saved
+	if ((regs[1] & (1u << 16)) && (xcr0 & 0xE6) == 0xE6)
+		return SIMD_AVX512;
+#endif
+	if (regs[1] & (1u << 5))
+		return SIMD_AVX2;
+#endif
+	return SIMD_SCALAR;
+}
+
+/*
+* Purpose: Get the name of an instruction set for the report
+* Parameters: SimdLevel
+* Returns: const char pointer
+*/
+const char* BatchClassifier::levelName(SimdLevel level) {
+	switch (level) {
+	case SIMD_AVX2:
+		return "avx2";
+	case SIMD_AVX512:
+		return "avx512";
+	default:
+		return "scalar";
+	}
+}
+
+/*
+* Purpose: Use a slower instruction set, a level this CPU does not support is lowered to the fastest one it does
+* Parameters: SimdLevel
+* Returns: None
+*/
+void BatchClassifier::setLevel(SimdLevel level) {
+	SimdLevel supported = detectLevel();
+	_level = (level > supported) ? supported : level;
+}
+
+/*
+* Purpose: Get the instruction set in use
+* Parameters: None
+* Returns: SimdLevel
+*/
+SimdLevel BatchClassifier::level() const {
+	return _level;
+}
+
+/*
+* Purpose: Classify the hands of a batch one at a time, starting from a hand
+* Parameters: HandBatch, Int index of the first hand
+* Returns: None
+*/
+void BatchClassifier::_classifyScalar(HandBatch& batch, int first) const {
+	for (int i = first; i < batch.size; ++i) {
+		HandMask hand = 0;
+		for (int c = 0; c < 5; ++c)
+			hand |= cardMask(batch.cards[c][i]);
+		batch.types[i] = (unsigned char)_evaluator.classifyMask(hand);
+	}
+}
+
+/*
+* Purpose: Classify every hand of a batch into batch.types
+* Parameters: HandBatch
+* Returns: None
+*/
+void BatchClassifier::classify(HandBatch& batch) const {
+	int done = 0;
+#if defined(BATCH_X86)
+#if defined(BATCH_AVX512)
+	if (_level == SIMD_AVX512)
+		done = classifyAvx512(batch, HandEvaluator::_handTable);
+#endif
+	if (_level == SIMD_AVX2)
+		done = classifyAvx2(batch, HandEvaluator::_handTable);
+#endif
+	// The hands left over after the last full vector
+	_classifyScalar(batch, done);
+}
@@ -0,0 +1,80 @@
+#if !defined(__BATCHCLASSIFIER_H__)
+#define __BATCHCLASSIFIER_H__
+/*
+* Program: PokerHandFrequencies
+* Module: BatchClassifier.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Classifies a batch of 5-card hands at once. The hands are stored as 5 arrays
+*      of card bytes (one array per card position), so 8 (AVX2) or 16 (AVX-512) hands are
+*      loaded and classified per instruction. The rank and suit bit of each card are shifted
+*      out of the card byte itself (see Card.h), with no table lookups. The rank histogram
+*      of each hand is kept bit sliced: three 13-bit masks hold the ones, twos and fours bit
+*      of every rank count, so pairs, triples and quadruples are found with AND, OR and XOR
+*      alone. The final hand-type comes from the same hand table as HandEvaluator::classify,
+*      so the results are identical to classifying the hands one at a time. The instruction
+*      set is picked when the program runs; other CPUs use the scalar classifier.
+*/
+
+#include "HandEvaluator.h"
+
+// The instruction sets the batch classifier can use, from slowest to fastest
+enum SimdLevel {
+	SIMD_SCALAR,
+	SIMD_AVX2,
+	SIMD_AVX512
+};
+
+// A batch of dealt hands with one array per card position
+struct HandBatch {
+	static const int SIZE = 256;
+
+	Card cards[5][SIZE];
+	unsigned char types[SIZE];
+	int size;
+
+	/*
+	* Purpose: Store a hand in the batch
+	* Parameters: Int index in the batch, Card array of 5 cards
+	* Returns: None
+	*/
+	inline void set(int index, const Card hand[5]) {
+		for (int i = 0; i < 5; ++i)
+			cards[i][index] = hand[i];
+	}
+
+	/*
+	* Purpose: Store a hand of cards numbered 0 - 51 in the batch
+	* Parameters: Int index in the batch, Int array of 5 cards numbered 0 - 51
+	* Returns: None
+	*/
+	inline void set(int index, const int hand[5]) {
+		for (int i = 0; i < 5; ++i)
+			cards[i][index] = cardFromIndex(hand[i]);
+	}
+};
+
+class BatchClassifier {
+public:
+
+	//Constructor/Deconstructor
+	BatchClassifier();
+	~BatchClassifier();
+
+	//Public Methods
+	void classify(HandBatch& batch) const;
+	void setLevel(SimdLevel level);
+	SimdLevel level() const;
+
+	// Public static methods
+	static SimdLevel detectLevel();
+	static const char* levelName(SimdLevel level);
+
+private:
+	void _classifyScalar(HandBatch& batch, int first) const;
+
+	//Member Variables
+	HandEvaluator _evaluator;
+	SimdLevel _level;
+};
+#endif
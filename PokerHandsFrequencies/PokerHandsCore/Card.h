@@ -0,0 +1,106 @@
+#if !defined(__CARD_H__)
+#define __CARD_H__
+/*
+* Program: PokerHandFrequencies
+* Module: Card.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: A card packed into one byte, the rank in bits 0 - 3 (0 is the ace, 12 the
+*      king) and the suit in bits 4 - 5, so a whole deck is 52 bytes and fits in one cache
+*      line. Reading the rank or suit is a mask or a shift instead of % 13 or / 13.
+*      A hand is a 64-bit mask with one bit per card: the bit of a card is the card's own
+*      value, so each suit has its own 16-bit field holding a 13-bit rank mask, and the
+*      ranks present, flushes and pairs all come from ANDs and ORs of the four fields.
+*      HandEvaluator::classify still takes cards numbered 0 - 51 (the index of a card,
+*      suit * 13 + rank), which is how hands are enumerated; cardFromIndex and cardIndex
+*      convert between the two.
+*/
+
+#include <cstdint>
+
+typedef unsigned char Card;
+typedef uint64_t HandMask;
+
+//Const
+static const int DECK_SIZE = 52;
+static const int RANKS_PER_SUIT = 13;
+static const int SUIT_SHIFT = 4;
+static const int SUIT_FIELD_BITS = 16;
+static const unsigned SUIT_RANKS = 0x1FFF;
+
+/*
+* Purpose: Make a card from its rank and suit
+* Parameters: Int rank 0 - 12, Int suit 0 - 3
+* Returns: Card
+*/
+inline Card makeCard(int rank, int suit) {
+	return (Card)((suit << SUIT_SHIFT) | rank);
+}
+
+/*
+* Purpose: Get the rank of a card, 0 (ace) - 12 (king)
+* Parameters: Card
+* Returns: Int
+*/
+inline int cardRank(Card card) {
+	return card & 0xF;
+}
+
+/*
+* Purpose: Get the suit of a card, 0 - 3
+* Parameters: Card
+* Returns: Int
+*/
+inline int cardSuit(Card card) {
+	return card >> SUIT_SHIFT;
+}
+
+/*
+* Purpose: Get the card numbered index (0 - 51) in the order HandEvaluator::classify uses,
+*		   rank = index % 13 and suit = index / 13
+* Parameters: Int index
+* Returns: Card
+*/
+inline Card cardFromIndex(int index) {
+	return makeCard(index % RANKS_PER_SUIT, index / RANKS_PER_SUIT);
+}
+
+/*
+* Purpose: Get the number 0 - 51 of a card, the inverse of cardFromIndex
+* Parameters: Card
+* Returns: Int
+*/
+inline int cardIndex(Card card) {
+	return cardSuit(card) * RANKS_PER_SUIT + cardRank(card);
+}
+
+/*
+* Purpose: Get the bit of a card in a hand mask
+* Parameters: Card
+* Returns: HandMask
+*/
+inline HandMask cardMask(Card card) {
+	return (HandMask)1 << card;
+}
+
+/*
+* Purpose: Get the mask of a number of cards
+* Parameters: Card array, Int number of cards
+* Returns: HandMask
+*/
+inline HandMask handMask(const Card* cards, int numCards) {
+	HandMask hand = 0;
+	for (int i = 0; i < numCards; ++i)
+		hand |= cardMask(cards[i]);
+	return hand;
+}
+
+/*
+* Purpose: Get the 13-bit mask of the ranks a hand holds in one suit
+* Parameters: HandMask, Int suit 0 - 3
+* Returns: unsigned
+*/
+inline unsigned suitRanks(HandMask hand, int suit) {
+	return (unsigned)(hand >> (suit * SUIT_FIELD_BITS)) & SUIT_RANKS;
+}
+#endif
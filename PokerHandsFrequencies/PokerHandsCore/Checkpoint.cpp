@@ -0,0 +1,196 @@
+/*
+* Program: PokerHandFrequencies
+* Module: Checkpoint.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Writes and reads the checkpoint of a checked run. See Checkpoint.h.
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "Checkpoint.h"
+#include "HandTables.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+using namespace std;
+
+//Const
+const char CHECKPOINT_MAGIC[8] = { 'P', 'H', 'F', 'C', 'H', 'E', 'C', 'K' };
+// Changes whenever the layout or the meaning of the file changes
+const uint32_t CHECKPOINT_VERSION = 1;
+// Reads back as 0x04030201 on a machine of the other byte order
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+// Segments a run can have before the stream numbers of a rank run out
+const uint32_t MAX_SEGMENTS = 0xFFFFFFFFu / SEGMENT_STREAMS;
+
+//Constructor
+Checkpoint::Checkpoint(){
+	seed = 0;
+	generator = RNG_XOSHIRO256;
+	cardsPerHand = 5;
+	segment = 0;
+	elapsed = 0;
+	previousElapsed = 0;
+}
+
+//Deconstructor
+Checkpoint::~Checkpoint(){
+}
+
+/*
+* Purpose: Start the checkpoints of a run (or of the segment a resumed run is) with no hands counted
+* Parameters: SimulationOptions of the run, Int number of ranks
+* Returns: None
+*/
+void Checkpoint::begin(const SimulationOptions& options, int numRanks) {
+	seed = options.seed;
+	generator = options.generator;
+	cardsPerHand = options.cardsPerHand;
+	segment = options.segment;
+	elapsed = previousElapsed;
+	rankCounts.assign(numRanks, HandCounts());
+}
+
+/*
+* Purpose: Read a checkpoint file and check it is whole
+* Parameters: string path, string set to what is wrong
+* Returns: bool - false if the file can not be read or is not a checkpoint of this version
+*/
+bool Checkpoint::read(const string& path, string& error) {
+	ifstream file(path.c_str(), ios::binary);
+	vector<unsigned char> image((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+	if (!file.is_open()) {
+		error = "can not open " + path;
+		return false;
+	}
+
+	CheckpointHeader header;
+	if (image.size() < sizeof(header) || memcmp(&image[0], CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0) {
+		error = path + " is not a checkpoint";
+		return false;
+	}
+	memcpy(&header, &image[0], sizeof(header));
+	uint64_t stored = header.checksum;
+	memset(&image[offsetof(CheckpointHeader, checksum)], 0, sizeof(header.checksum));
+	if (header.byteOrder != BYTE_ORDER_MARK)
+		error = path + " was written on a machine of the other byte order";
+	else if (header.version != CHECKPOINT_VERSION)
+		error = path + " is from another version";
+	else if (header.ranks == 0 || image.size() != sizeof(header) + header.ranks * sizeof(previous.count)
+		|| HandTables::checksum(&image[0], image.size()) != stored)
+		error = path + " is cut short or damaged";
+	if (!error.empty())
+		return false;
+
+	seed = header.seed;
+	generator = (RngType)header.generator;
+	cardsPerHand = (int)header.cardsPerHand;
+	segment = header.segment;
+	elapsed = header.elapsed;
+	copy(header.previous, header.previous + NUM_HAND_TYPES, previous.count.begin());
+	rankCounts.assign(header.ranks, HandCounts());
+	const unsigned char* counts = &image[sizeof(header)];
+	for (uint32_t rank = 0; rank < header.ranks; ++rank)
+		memcpy(rankCounts[rank].count.data(), counts + rank * sizeof(previous.count), sizeof(previous.count));
+	if (total().total() != header.hands) {
+		error = path + " is cut short or damaged";
+		return false;
+	}
+	return true;
+}
+
+/*
+* Purpose: Write the checkpoint to a temporary file next to the path, then rename it over the path
+* Parameters: string path, string set to what went wrong
+* Returns: bool - false if the file can not be written, in which case the last checkpoint is kept
+*/
+bool Checkpoint::write(const string& path, string& error) const {
+	CheckpointHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+	header.version = CHECKPOINT_VERSION;
+	header.byteOrder = BYTE_ORDER_MARK;
+	header.seed = seed;
+	header.generator = (uint32_t)generator;
+	header.cardsPerHand = (uint32_t)cardsPerHand;
+	header.segment = segment;
+	header.ranks = (uint32_t)rankCounts.size();
+	header.hands = total().total();
+	header.elapsed = elapsed;
+	copy(previous.count.begin(), previous.count.end(), header.previous);
+
+	vector<unsigned char> image(sizeof(header) + rankCounts.size() * sizeof(previous.count));
+	memcpy(&image[0], &header, sizeof(header));
+	for (size_t rank = 0; rank < rankCounts.size(); ++rank)
+		memcpy(&image[sizeof(header) + rank * sizeof(previous.count)], rankCounts[rank].count.data(), sizeof(previous.count));
+	uint64_t sum = HandTables::checksum(&image[0], image.size());
+	memcpy(&image[offsetof(CheckpointHeader, checksum)], &sum, sizeof(sum));
+
+	string temporary = path + ".tmp";
+	{
+		ofstream file(temporary.c_str(), ios::binary | ios::trunc);
+		file.write((const char*)&image[0], (streamsize)image.size());
+		if (!file) {
+			error = "can not write " + temporary;
+			return false;
+		}
+	}
+#if defined(_WIN32)
+	bool renamed = MoveFileExA(temporary.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	bool renamed = rename(temporary.c_str(), path.c_str()) == 0;
+#endif
+	if (!renamed) {
+		error = "can not rename " + temporary + " to " + path;
+		return false;
+	}
+	return true;
+}
+
+/*
+* Purpose: Make the options of a run carry on from this checkpoint: the same seed, and the next segment
+*		   for streams no earlier segment used. The counts so far become the counts before this segment.
+* Parameters: SimulationOptions to change, string set to what does not match
+* Returns: bool - false if the checkpoint is of a run with other options
+*/
+bool Checkpoint::resume(SimulationOptions& options, string& error) {
+	if (options.seedGiven && options.seed != seed)
+		error = "the checkpoint is of a run with another seed";
+	else if (options.generator != generator)
+		error = string("the checkpoint is of a run with the ") + RandomStream::typeName(generator) + " generator";
+	else if (options.cardsPerHand != cardsPerHand)
+		error = "the checkpoint is of a run with another number of cards per hand";
+	else if (segment + 1 >= MAX_SEGMENTS)
+		error = "the run has been resumed too many times";
+	if (!error.empty())
+		return false;
+
+	options.seed = seed;
+	options.segment = segment + 1;
+	previous = total();
+	previousElapsed = elapsed;
+	rankCounts.clear();
+	return true;
+}
+
+/*
+* Purpose: Get the counts of every segment so far
+* Parameters: None
+* Returns: HandCounts
+*/
+HandCounts Checkpoint::total() const {
+	HandCounts sum = previous;
+	for (size_t rank = 0; rank < rankCounts.size(); ++rank)
+		sum.add(rankCounts[rank]);
+	return sum;
+}
@@ -0,0 +1,76 @@
+#if !defined(__CHECKPOINT_H__)
+#define __CHECKPOINT_H__
+/*
+* Program: PokerHandFrequencies
+* Module: Checkpoint.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: The counts of a checked run (--tolerance, --max-hands or --max-seconds) saved
+*      every --checkpoint-seconds to the --checkpoint file, so a run killed at a job's wall
+*      clock limit can carry on from its last checkpoint with --resume. The file holds the
+*      hand-type counts of each rank (process), the counts of the segments before the one that
+*      wrote it, the run's elapsed time and what every random number stream came from: the
+*      generator, the seed and the segment. A run that resumes is the next segment, and the
+*      threads of segment s use streams s * SEGMENT_STREAMS + thread of their rank, which no
+*      earlier segment used, so the hands it deals are independent of the ones already counted.
+*      Like the table files (see HandTables) the file starts with a magic string, a format
+*      version, a byte order mark and a checksum. It is written to a temporary file that is
+*      then renamed over the old one, so a run killed while writing leaves the last checkpoint.
+*/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "HandCounts.h"
+#include "Random.h"
+#include "SimulationOptions.h"
+
+//Const
+// Streams each rank can use in one segment, so also the most threads a checkpointed run can have
+static const uint32_t SEGMENT_STREAMS = 4096;
+
+// The start of a checkpoint file, followed by the counts of each rank. Every field is a fixed size.
+struct CheckpointHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	uint64_t checksum;
+	uint64_t seed;
+	uint32_t generator;
+	uint32_t cardsPerHand;
+	uint32_t segment;
+	uint32_t ranks;
+	uint64_t hands;
+	double elapsed;
+	uint64_t previous[NUM_HAND_TYPES];
+};
+
+class Checkpoint {
+public:
+
+	//Constructor/Deconstructor
+	Checkpoint();
+	~Checkpoint();
+
+	//Public Methods
+	void begin(const SimulationOptions& options, int numRanks);
+	bool read(const std::string& path, std::string& error);
+	bool write(const std::string& path, std::string& error) const;
+	bool resume(SimulationOptions& options, std::string& error);
+	HandCounts total() const;
+
+	//Member Variables
+	uint64_t seed;
+	RngType generator;
+	int cardsPerHand;
+	uint32_t segment;
+	// Seconds since the first segment started, and how many of them were before this segment
+	double elapsed;
+	double previousElapsed;
+	// Counts of every segment before this one
+	HandCounts previous;
+	// Counts of each rank in this segment
+	std::vector<HandCounts> rankCounts;
+};
+#endif
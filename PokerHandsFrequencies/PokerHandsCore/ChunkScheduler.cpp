@@ -0,0 +1,93 @@
+/*
+* Program: PokerHandFrequencies
+* Module: ChunkScheduler.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Guided self-scheduling of the hands of a --hands run. See ChunkScheduler.h.
+*/
+
+#include <algorithm>
+
+#include "ChunkScheduler.h"
+
+using namespace std;
+
+//Constructor
+ChunkScheduler::ChunkScheduler(uint64_t numHands, int totalThreads){
+	_end = numHands;
+	_totalThreads = max(totalThreads, 1);
+	_next.store(0);
+	_chunks.store(0);
+}
+
+//Deconstructor
+ChunkScheduler::~ChunkScheduler(){
+}
+
+/*
+* Purpose: Take a guided chunk for a process: its threads' share of half the hands left, and at
+*		   least MIN_CHUNK_HANDS per thread (or what is left)
+* Parameters: Int threads of the process, uint64_t begin and end set to the chunk's range
+* Returns: bool - false once every hand has been handed out
+*/
+bool ChunkScheduler::take(int threads, uint64_t& begin, uint64_t& end) {
+	return _take(0, true, threads, begin, end);
+}
+
+/*
+* Purpose: Take a block of a fixed size (or what is left) for a thread of this process
+* Parameters: uint64_t hands in the block, uint64_t begin and end set to the block's range
+* Returns: bool - false once every hand has been handed out
+*/
+bool ChunkScheduler::takeBlock(uint64_t size, uint64_t& begin, uint64_t& end) {
+	return _take(size, false, 0, begin, end);
+}
+
+/*
+* Purpose: Get the number of hands not handed out yet
+* Parameters: None
+* Returns: uint64_t
+*/
+uint64_t ChunkScheduler::remaining() const {
+	return _end - min(_next.load(), _end);
+}
+
+/*
+* Purpose: Get the number of guided chunks handed out
+* Parameters: None
+* Returns: uint64_t
+*/
+uint64_t ChunkScheduler::chunks() const {
+	return _chunks.load();
+}
+
+/*
+* Purpose: Move the start of the hands left past a chunk. The size of a guided chunk depends on
+*		   what is left, so it is worked out again if another thread took a chunk first.
+* Parameters: uint64_t size of a block, bool guided, Int threads of the process a guided chunk is
+*			  for, uint64_t begin and end set to the range taken
+* Returns: bool - false once every hand has been handed out
+*/
+bool ChunkScheduler::_take(uint64_t size, bool guided, int threads, uint64_t& begin, uint64_t& end) {
+	uint64_t next = _next.load();
+	uint64_t chunk;
+	do {
+		if (next >= _end)
+			return false;
+		uint64_t left = _end - next;
+		if (guided) {
+			uint64_t share = (left + 2 * _totalThreads - 1) / (2 * _totalThreads);
+			chunk = max(share, (uint64_t)MIN_CHUNK_HANDS) * threads;
+		}
+		else {
+			chunk = max<uint64_t>(size, 1);
+		}
+		chunk = min(chunk, left);
+	} while (!_next.compare_exchange_weak(next, next + chunk));
+
+	begin = next;
+	end = next + chunk;
+	if (guided)
+		++_chunks;
+	return true;
+}
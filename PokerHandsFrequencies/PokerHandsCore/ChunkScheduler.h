@@ -0,0 +1,49 @@
+#if !defined(__CHUNKSCHEDULER_H__)
+#define __CHUNKSCHEDULER_H__
+/*
+* Program: PokerHandFrequencies
+* Module: ChunkScheduler.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Splits a run of a fixed number of hands (--hands) into chunks handed out on
+*      demand, so a fast process takes more chunks than a slow one. Chunks are ranges of hand
+*      indices [begin, end). A process asking from afar gets a guided chunk: its threads' share
+*      of half the hands left, so chunks start large (few requests) and shrink towards the end
+*      (a slow process is never left holding much). Half, because a process fetches its next
+*      chunk while it deals the one before, so it can hold two. Threads of the process that owns
+*      the scheduler take small fixed blocks instead, which cost no message. Safe to take from
+*      any thread; knows nothing of MPI.
+*/
+
+#include <atomic>
+#include <cstdint>
+
+class ChunkScheduler {
+public:
+
+	//Constructor/Deconstructor
+	ChunkScheduler(uint64_t numHands, int totalThreads);
+	~ChunkScheduler();
+
+	//Public Methods
+	bool take(int threads, uint64_t& begin, uint64_t& end);
+	bool takeBlock(uint64_t size, uint64_t& begin, uint64_t& end);
+	uint64_t remaining() const;
+	uint64_t chunks() const;
+
+	//Const
+	// A guided chunk is never less than this many hands per thread, so the time it takes to deal
+	// (about a quarter of a millisecond) stays well above the time to ask for it
+	static const uint64_t MIN_CHUNK_HANDS = 1 << 14;
+
+private:
+	bool _take(uint64_t size, bool guided, int threads, uint64_t& begin, uint64_t& end);
+
+	//Member Variables
+	uint64_t _end;
+	int _totalThreads;
+	std::atomic<uint64_t> _next;
+	// Guided chunks handed out
+	std::atomic<uint64_t> _chunks;
+};
+#endif
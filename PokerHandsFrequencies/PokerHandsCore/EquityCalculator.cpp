@@ -0,0 +1,474 @@
+/*
+* Program: PokerHandFrequencies
+* Module: EquityCalculator.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Texas Hold'em equity of a batch of matchups. See EquityCalculator.h.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include "EquityCalculator.h"
+#include "HandEnumerator.h"
+#include "HandTables.h"
+#include "ReportFormatter.h"
+
+using namespace std;
+
+//Const
+// A matchup with at most this many boards left is enumerated, every matchup after the flop is
+const uint64_t EXHAUSTIVE_BOARDS = 500000;
+// 95% half width of each player's equity the random boards aim for when no --tolerance is given
+const double DEFAULT_EQUITY_TOLERANCE = 0.001;
+// Random boards are dealt in batches of this many between checks of the interval
+const uint64_t SAMPLE_BATCH = 10000;
+// The most random boards dealt for one matchup when no --max-hands is given
+const uint64_t MAX_SAMPLED_BOARDS = 100000000;
+const char RANK_NAMES[] = "A23456789TJQK";
+const char SUIT_NAMES[] = "shdc";
+// Width of the hand column of the equity report, as wide as the hand-type column
+const int PLAYER_WIDTH = 15;
+
+/*
+* Purpose: Zero every count of the tally
+* Parameters: None
+* Returns: None
+*/
+void EquityTally::clear() {
+	boards = 0;
+	fill(wins, wins + MAX_PLAYERS, 0.0);
+	fill(ties, ties + MAX_PLAYERS, 0.0);
+	fill(shares, shares + MAX_PLAYERS, 0.0);
+	fill(shareSquares, shareSquares + MAX_PLAYERS, 0.0);
+}
+
+/*
+* Purpose: Add the boards of another tally of the same matchup
+* Parameters: EquityTally
+* Returns: None
+*/
+void EquityTally::add(const EquityTally& other) {
+	boards += other.boards;
+	for (int player = 0; player < MAX_PLAYERS; ++player) {
+		wins[player] += other.wins[player];
+		ties[player] += other.ties[player];
+		shares[player] += other.shares[player];
+		shareSquares[player] += other.shareSquares[player];
+	}
+}
+
+/*
+* Purpose: Get a player's equity, the share of the pot they win on average
+* Parameters: Int player
+* Returns: double - between 0 and 1
+*/
+double EquityTally::equity(int player) const {
+	return (boards > 0) ? shares[player] / boards : 0.0;
+}
+
+/*
+* Purpose: Get the half width of the 95% interval of a player's equity over random boards
+* Parameters: Int player
+* Returns: double
+*/
+double EquityTally::halfWidth(int player) const {
+	if (boards < 2)
+		return 1.0;
+	double mean = shares[player] / boards;
+	double variance = max(0.0, shareSquares[player] / boards - mean * mean);
+	return 1.96 * sqrt(variance / (boards - 1));
+}
+
+//Constructor
+EquityCalculator::EquityCalculator(const SimulationOptions& options, const HandTables* tables){
+	_options = &options;
+	_tables = tables;
+	_tolerance = (options.tolerance > 0) ? options.tolerance : DEFAULT_EQUITY_TOLERANCE;
+	_maxBoards = (options.maxHands > 0) ? options.maxHands : MAX_SAMPLED_BOARDS;
+}
+
+//Deconstructor
+EquityCalculator::~EquityCalculator(){
+}
+
+/*
+* Purpose: Tally this process's part of the boards of a matchup: its range of every board when there
+*		   are few enough of them, random boards otherwise. The random boards come from a stream seeded
+*		   from the seed and the matchup's index, so a seed gives the same equities however the
+*		   matchups fall on the threads.
+*		   A matchup found in the table is only tallied by the first part.
+* Parameters: Matchup, Int index of the matchup in its batch, Int part (the rank), Int parts (the
+*			  number of processes), EquityTally to add the boards to
+* Returns: None
+*/
+void EquityCalculator::calculate(const Matchup& matchup, int index, int part, int parts, EquityTally& tally) {
+	switch (method(matchup, *_options, _tables)) {
+	case EQUITY_TABLE:
+		if (part == 0)
+			_lookUp(matchup, tally);
+		break;
+	case EQUITY_EXACT: {
+		uint64_t begin, end;
+		HandEnumerator::splitRange(boardCount(matchup), parts, part, begin, end);
+		_enumerate(matchup, begin, end, tally);
+		break;
+	}
+	case EQUITY_SAMPLED:
+		_random.seed(_options->generator, RandomStream::subSeed(_options->seed, index), part);
+		_sample(matchup, _tolerance * sqrt((double)parts), max<uint64_t>(1, _maxBoards / parts), tally);
+		break;
+	}
+}
+
+/*
+* Purpose: Calculate the equities of a batch of matchups on the threads of a pool. Each thread takes
+*		   the next matchup nobody has started until none are left.
+* Parameters: WorkerPool, SimulationOptions, Int part (the rank), Int parts (the number of processes),
+*			  Matchup vector, EquityTally vector of the same size to add the boards to, HandTables or null
+* Returns: None
+*/
+void EquityCalculator::calculateAll(WorkerPool& pool, const SimulationOptions& options, int part, int parts,
+	const vector<Matchup>& matchups, vector<EquityTally>& tallies, const HandTables* tables) {
+	// Made here so the evaluator's tables are built before the threads start
+	vector<EquityCalculator> calculators(pool.size(), EquityCalculator(options, tables));
+	atomic<int> nextMatchup(0);
+	int numMatchups = (int)matchups.size();
+	pool.run([&](HandWorker&, int thread) {
+		for (int index = nextMatchup++; index < numMatchups; index = nextMatchup++)
+			calculators[thread].calculate(matchups[index], index, part, parts, tallies[index]);
+	});
+}
+
+/*
+* Purpose: Choose how to find the equities of a matchup: from the table when it is one hand against a
+*		   random hand before the flop, by dealing every board when there are few enough of them (and
+*		   no random hands), by random boards otherwise
+* Parameters: Matchup, SimulationOptions, HandTables or null
+* Returns: EquityMethod
+*/
+EquityMethod EquityCalculator::method(const Matchup& matchup, const SimulationOptions& options, const HandTables* tables) {
+	if (tables && tables->isOpen() && matchup.players.size() == 2 && matchup.randomPlayers == 1 && matchup.boardCards == 0)
+		return EQUITY_TABLE;
+	if (matchup.randomPlayers == 0 && (options.exhaustive || boardCount(matchup) <= EXHAUSTIVE_BOARDS))
+		return EQUITY_EXACT;
+	return EQUITY_SAMPLED;
+}
+
+/*
+* Purpose: Count the ways the rest of the board can come, the hands of random players aside
+* Parameters: Matchup
+* Returns: uint64_t
+*/
+uint64_t EquityCalculator::boardCount(const Matchup& matchup) {
+	int knownPlayers = (int)matchup.players.size() - matchup.randomPlayers;
+	int deckLeft = DECK_SIZE - HOLE_CARDS * knownPlayers - matchup.boardCards;
+	return HandEnumerator::combinations(deckLeft, BOARD_CARDS - matchup.boardCards);
+}
+
+/*
+* Purpose: Print the equity of each hand of a matchup, how often it wins and ties, and how many boards
+*		   were dealt. Random boards also show the 95% half width of each equity.
+* Parameters: ostream, Matchup, EquityTally, EquityMethod the equities were found by
+* Returns: None
+*/
+void EquityCalculator::printEquity(ostream& out, const Matchup& matchup, const EquityTally& tally, EquityMethod method) {
+	string hands = matchup.playerNames[0];
+	for (size_t player = 1; player < matchup.playerNames.size(); ++player)
+		hands += " vs " + matchup.playerNames[player];
+	ReportFormatter::printField(out, "Matchup", hands);
+	ReportFormatter::printField(out, "Board", matchup.boardName.empty() ? "-" : matchup.boardName);
+	out << "             Hand      Equity (%)         Win (%)         Tie (%)     +/- (%)\n";
+	out << fixed << setprecision(3);
+	for (size_t player = 0; player < matchup.players.size(); ++player) {
+		int p = (int)player;
+		double boards = (tally.boards > 0) ? tally.boards : 1;
+		out << "  " << setw(PLAYER_WIDTH) << matchup.playerNames[player]
+			<< setw(16) << 100.0 * tally.equity(p) << setw(16) << 100.0 * tally.wins[p] / boards
+			<< setw(16) << 100.0 * tally.ties[p] / boards;
+		if (method == EQUITY_SAMPLED)
+			out << setw(12) << 100.0 * tally.halfWidth(p) << '\n';
+		else
+			out << setw(12) << ((method == EQUITY_EXACT) ? "exact" : "table") << '\n';
+	}
+	out << setprecision(0);
+	if (method == EQUITY_TABLE)
+		ReportFormatter::printField(out, "Boards", "from the table");
+	else
+		ReportFormatter::printField(out, (method == EQUITY_EXACT) ? "Every Board" : "Random Boards", tally.boards);
+	ReportFormatter::printRule(out);
+}
+
+/*
+* Purpose: Score every board in a range of the colex order of the ways to finish the board
+* Parameters: Matchup, uint64_t begin, uint64_t end, EquityTally
+* Returns: None
+*/
+void EquityCalculator::_enumerate(const Matchup& matchup, uint64_t begin, uint64_t end, EquityTally& tally) {
+	if (begin >= end)
+		return;
+	Card deck[DECK_SIZE];
+	_remainingDeck(matchup, deck);
+	int cardsLeft = BOARD_CARDS - matchup.boardCards;
+
+	int board[BOARD_CARDS] = { 0 };
+	HandEnumerator::unrank(begin, board, cardsLeft);
+	for (uint64_t index = begin; index < end; ++index) {
+		HandMask cards = matchup.board;
+		for (int i = 0; i < cardsLeft; ++i)
+			cards |= cardMask(deck[board[i]]);
+		_score(matchup.players.data(), (int)matchup.players.size(), cards, tally);
+		HandEnumerator::next(board, cardsLeft);
+	}
+}
+
+/*
+* Purpose: Score random boards in batches until the 95% interval of every player's equity is within the
+*		   tolerance or the most boards have been dealt. The rest of the board, then the hole cards of
+*		   the random players, are the first cards of a partial Fisher-Yates shuffle of the cards left.
+* Parameters: Matchup, double tolerance, uint64_t maxBoards, EquityTally
+* Returns: None
+*/
+void EquityCalculator::_sample(const Matchup& matchup, double tolerance, uint64_t maxBoards, EquityTally& tally) {
+	Card deck[DECK_SIZE];
+	int deckLeft = _remainingDeck(matchup, deck);
+	int cardsLeft = BOARD_CARDS - matchup.boardCards;
+	int numPlayers = (int)matchup.players.size();
+	HandMask players[MAX_PLAYERS];
+	copy(matchup.players.begin(), matchup.players.end(), players);
+
+	uint64_t dealt = 0;
+	for (;;) {
+		uint64_t batch = min(SAMPLE_BATCH, maxBoards - dealt);
+		for (uint64_t i = 0; i < batch; ++i) {
+			HandMask cards = matchup.board;
+			for (int card = 0; card < cardsLeft; ++card) {
+				swap(deck[card], deck[card + _random.nextBelow(deckLeft - card)]);
+				cards |= cardMask(deck[card]);
+			}
+			int next = cardsLeft;
+			for (int player = 0; player < numPlayers; ++player) {
+				if (matchup.players[player])
+					continue;
+				players[player] = 0;
+				for (int card = next; card < next + HOLE_CARDS; ++card) {
+					swap(deck[card], deck[card + _random.nextBelow(deckLeft - card)]);
+					players[player] |= cardMask(deck[card]);
+				}
+				next += HOLE_CARDS;
+			}
+			_score(players, numPlayers, cards, tally);
+		}
+		dealt += batch;
+		if (dealt >= maxBoards)
+			return;
+
+		double widest = 0;
+		for (int player = 0; player < numPlayers; ++player)
+			widest = max(widest, tally.halfWidth(player));
+		if (widest <= tolerance)
+			return;
+	}
+}
+
+/*
+* Purpose: Find the best hand on one board and give the pot to it, split evenly between tied players
+* Parameters: HandMask array of each player's hole cards, Int number of players, HandMask of the 5 board
+*			  cards, EquityTally
+* Returns: None
+*/
+void EquityCalculator::_score(const HandMask* players, int numPlayers, HandMask board, EquityTally& tally) {
+	HandStrength strengths[MAX_PLAYERS];
+	HandStrength best = 0;
+	for (int player = 0; player < numPlayers; ++player) {
+		strengths[player] = _evaluator.strength(players[player] | board);
+		best = max(best, strengths[player]);
+	}
+
+	int winners = 0;
+	for (int player = 0; player < numPlayers; ++player)
+		winners += (strengths[player] == best);
+
+	double share = 1.0 / winners;
+	for (int player = 0; player < numPlayers; ++player) {
+		if (strengths[player] != best)
+			continue;
+		if (winners == 1)
+			++tally.wins[player];
+		else
+			++tally.ties[player];
+		tally.shares[player] += share;
+		tally.shareSquares[player] += share * share;
+	}
+	++tally.boards;
+}
+
+/*
+* Purpose: Tally a hand against a random hand before the flop from the table, as one board whose wins,
+*		   ties and pot shares are the table's rates
+* Parameters: Matchup, EquityTally
+* Returns: None
+*/
+void EquityCalculator::_lookUp(const Matchup& matchup, EquityTally& tally) {
+	int known = matchup.players[0] ? 0 : 1;
+	const PreflopEquity& preflop = _tables->preflop(HandTables::startingHand(matchup.players[known]));
+	tally.boards += 1;
+	tally.wins[known] += preflop.win;
+	tally.ties[known] += preflop.tie;
+	tally.shares[known] += preflop.equity;
+	tally.wins[1 - known] += 1.0 - preflop.win - preflop.tie;
+	tally.ties[1 - known] += preflop.tie;
+	tally.shares[1 - known] += 1.0 - preflop.equity;
+}
+
+/*
+* Purpose: List the cards not held by a player or already on the board, in card order
+* Parameters: Matchup, Card array to fill
+* Returns: Int number of cards left
+*/
+int EquityCalculator::_remainingDeck(const Matchup& matchup, Card deck[DECK_SIZE]) const {
+	HandMask used = matchup.board;
+	for (size_t player = 0; player < matchup.players.size(); ++player)
+		used |= matchup.players[player];
+
+	int cardsLeft = 0;
+	for (int index = 0; index < DECK_SIZE; ++index) {
+		Card card = cardFromIndex(index);
+		if (!(used & cardMask(card)))
+			deck[cardsLeft++] = card;
+	}
+	return cardsLeft;
+}
+
+/*
+* Purpose: Read a batch of matchups, one per line. Blank lines and anything after a # are skipped.
+* Parameters: istream, Matchup vector to add to, string set to the first error
+* Returns: bool - false if a line is not a valid matchup
+*/
+bool EquityCalculator::readMatchups(istream& in, vector<Matchup>& matchups, string& error) {
+	string line;
+	for (int lineNumber = 1; getline(in, line); ++lineNumber) {
+		line = line.substr(0, line.find('#'));
+		if (line.find_first_not_of(" \t\r") == string::npos)
+			continue;
+
+		Matchup matchup;
+		if (!parseMatchup(line, matchup, error)) {
+			ostringstream where;
+			where << "line " << lineNumber << ": " << error;
+			error = where.str();
+			return false;
+		}
+		matchups.push_back(matchup);
+	}
+	if (matchups.empty()) {
+		error = "no matchups";
+		return false;
+	}
+	return true;
+}
+
+/*
+* Purpose: Read one matchup: the hole cards of each player, optionally separated by "vs", then
+*		   optionally a | and the cards on the board, e.g. "AhKh vs QsQd | Jc Tc 2d". A card is its
+*		   rank (A, 2 - 9, T, J, Q, K) and suit (s, h, d, c); a player can be "random".
+* Parameters: string line, Matchup to fill, string set to what is wrong
+* Returns: bool - false if the line is not a valid matchup
+*/
+bool EquityCalculator::parseMatchup(const string& line, Matchup& matchup, string& error) {
+	size_t bar = line.find('|');
+	istringstream hands(line.substr(0, bar));
+	HandMask used = 0;
+
+	string token;
+	while (hands >> token) {
+		if (token == "vs")
+			continue;
+		if (token == "random") {
+			matchup.players.push_back(0);
+			matchup.playerNames.push_back(token);
+			++matchup.randomPlayers;
+			continue;
+		}
+		vector<Card> cards;
+		if (!_parseCards(token, cards) || cards.size() != HOLE_CARDS) {
+			error = "\"" + token + "\" is not two hole cards";
+			return false;
+		}
+		HandMask hand = handMask(cards.data(), HOLE_CARDS);
+		if ((hand & used) || cards[0] == cards[1]) {
+			error = "a card is dealt twice in \"" + token + "\"";
+			return false;
+		}
+		used |= hand;
+		matchup.players.push_back(hand);
+		matchup.playerNames.push_back(cardName(cards[0]) + cardName(cards[1]));
+	}
+	if (matchup.players.size() < 2 || matchup.players.size() > MAX_PLAYERS) {
+		ostringstream message;
+		message << "a matchup needs 2 - " << MAX_PLAYERS << " hands";
+		error = message.str();
+		return false;
+	}
+
+	if (bar != string::npos) {
+		istringstream boardText(line.substr(bar + 1));
+		vector<Card> board;
+		while (boardText >> token) {
+			if (!_parseCards(token, board)) {
+				error = "\"" + token + "\" is not a list of board cards";
+				return false;
+			}
+		}
+		if (board.size() > BOARD_CARDS) {
+			error = "the board has more than 5 cards";
+			return false;
+		}
+		for (size_t i = 0; i < board.size(); ++i) {
+			if (used & cardMask(board[i])) {
+				error = "board card " + cardName(board[i]) + " is dealt twice";
+				return false;
+			}
+			used |= cardMask(board[i]);
+			matchup.boardName += (i > 0 ? " " : "") + cardName(board[i]);
+		}
+		matchup.board = handMask(board.data(), (int)board.size());
+		matchup.boardCards = (int)board.size();
+	}
+	return true;
+}
+
+/*
+* Purpose: Get the name of a card, e.g. "Ah" or "Td"
+* Parameters: Card
+* Returns: string
+*/
+string EquityCalculator::cardName(Card card) {
+	string name;
+	name += RANK_NAMES[cardRank(card)];
+	name += SUIT_NAMES[cardSuit(card)];
+	return name;
+}
+
+/*
+* Purpose: Read cards written back to back, e.g. "AhKh", and add them to a list
+* Parameters: string text, Card vector to add to
+* Returns: bool - false if the text is not whole cards
+*/
+bool EquityCalculator::_parseCards(const string& text, vector<Card>& cards) {
+	if (text.empty() || text.size() % 2 != 0)
+		return false;
+	for (size_t i = 0; i < text.size(); i += 2) {
+		const char* rank = strchr(RANK_NAMES, toupper((unsigned char)text[i]));
+		const char* suit = strchr(SUIT_NAMES, tolower((unsigned char)text[i + 1]));
+		if (!rank || !suit || !*rank || !*suit)
+			return false;
+		cards.push_back(makeCard((int)(rank - RANK_NAMES), (int)(suit - SUIT_NAMES)));
+	}
+	return true;
+}
@@ -0,0 +1,135 @@
+#if !defined(__EQUITYCALCULATOR_H__)
+#define __EQUITYCALCULATOR_H__
+/*
+* Program: PokerHandFrequencies
+* Module: EquityCalculator.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Texas Hold'em equity of two or more hands of hole cards, with or without some
+*      of the board dealt, e.g. "AhKh vs QsQd | Jc Tc 2d". A player's equity is the share of
+*      the pot they win on average over every way the rest of the board can come: a win counts
+*      1 and a tie for the best hand 1 / (number of players tied). Each board is scored with
+*      SevenCardEvaluator::strength on the player's 2 cards and the 5 on the board.
+*      When there are few boards left (any matchup after the flop) every one of them is dealt
+*      in colex order, split into ranges between the processes; otherwise boards are dealt at
+*      random in batches until the 95% interval of every player's equity is within the
+*      tolerance. Each process deals its own boards from its own stream and aims for a
+*      tolerance sqrt(processes) times wider, so the summed boards of every process reach the
+*      tolerance without the processes talking until the end.
+*      A player can also be "random", a hand dealt with each board, whose matchups are always
+*      played on random boards. With a table file (see HandTables) one hand against one random
+*      hand before the flop is read from the table instead.
+*      A batch of matchups is read from a file, one per line, and the threads of a process
+*      take matchups one at a time until none are left.
+*/
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Card.h"
+#include "Random.h"
+#include "SevenCardEvaluator.h"
+#include "SimulationOptions.h"
+#include "WorkerPool.h"
+
+class HandTables;
+
+//Const
+static const int MAX_PLAYERS = 10;
+static const int HOLE_CARDS = 2;
+static const int BOARD_CARDS = 5;
+
+// How the equities of a matchup are found
+enum EquityMethod {
+	EQUITY_EXACT,
+	EQUITY_SAMPLED,
+	EQUITY_TABLE
+};
+
+// The cards of one matchup, read from one line of a matchup file
+struct Matchup {
+
+	//Constructor
+	Matchup() : board(0), boardCards(0), randomPlayers(0) {
+	}
+
+	//Member Variables
+	// The hole cards of each player, 0 for a random hand
+	std::vector<HandMask> players;
+	std::vector<std::string> playerNames;
+	HandMask board;
+	int boardCards;
+	std::string boardName;
+	int randomPlayers;
+};
+
+// The boards one process dealt for a matchup. Every member is a double so a whole batch of
+// tallies can be summed on the master with one MPI_Reduce of MPI_DOUBLE.
+struct EquityTally {
+
+	//Constructor
+	EquityTally() {
+		clear();
+	}
+
+	//Public Methods
+	void clear();
+	void add(const EquityTally& other);
+	double equity(int player) const;
+	double halfWidth(int player) const;
+
+	//Member Variables
+	double boards;
+	// Boards won outright, boards tied for the best hand
+	double wins[MAX_PLAYERS];
+	double ties[MAX_PLAYERS];
+	// The pot shares won and their squares, for the equity and its interval
+	double shares[MAX_PLAYERS];
+	double shareSquares[MAX_PLAYERS];
+};
+
+static const int EQUITY_TALLY_VALUES = 1 + 4 * MAX_PLAYERS;
+static_assert(sizeof(EquityTally) == EQUITY_TALLY_VALUES * sizeof(double), "EquityTally must be an array of doubles");
+
+class EquityCalculator {
+public:
+
+	//Constructor/Deconstructor
+	EquityCalculator(const SimulationOptions& options, const HandTables* tables = 0);
+	~EquityCalculator();
+
+	//Public Methods
+	void calculate(const Matchup& matchup, int index, int part, int parts, EquityTally& tally);
+
+	// Public static methods
+	static void calculateAll(WorkerPool& pool, const SimulationOptions& options, int part, int parts,
+		const std::vector<Matchup>& matchups, std::vector<EquityTally>& tallies, const HandTables* tables = 0);
+	static EquityMethod method(const Matchup& matchup, const SimulationOptions& options, const HandTables* tables = 0);
+	static uint64_t boardCount(const Matchup& matchup);
+	static void printEquity(std::ostream& out, const Matchup& matchup, const EquityTally& tally, EquityMethod method);
+	static bool readMatchups(std::istream& in, std::vector<Matchup>& matchups, std::string& error);
+	static bool parseMatchup(const std::string& line, Matchup& matchup, std::string& error);
+	static std::string cardName(Card card);
+
+private:
+	void _enumerate(const Matchup& matchup, uint64_t begin, uint64_t end, EquityTally& tally);
+	void _sample(const Matchup& matchup, double tolerance, uint64_t maxBoards, EquityTally& tally);
+	void _score(const HandMask* players, int numPlayers, HandMask board, EquityTally& tally);
+	void _lookUp(const Matchup& matchup, EquityTally& tally);
+	int _remainingDeck(const Matchup& matchup, Card deck[DECK_SIZE]) const;
+
+	// Private static method
+	static bool _parseCards(const std::string& text, std::vector<Card>& cards);
+
+	//Member Variables
+	const SimulationOptions* _options;
+	const HandTables* _tables;
+	SevenCardEvaluator _evaluator;
+	RandomStream _random;
+	double _tolerance;
+	uint64_t _maxBoards;
+};
+#endif
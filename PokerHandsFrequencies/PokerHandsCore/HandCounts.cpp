@@ -0,0 +1,53 @@
+/*
+* Program: PokerHandFrequencies
+* Module: HandCounts.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Number of hands drawn of each hand-type.
+*/
+
+#include "HandCounts.h"
+
+/*
+* Purpose: Get the total number of hands counted
+* Parameters: None
+* Returns: uint64_t
+*/
+uint64_t HandCounts::total() const {
+	uint64_t sum = 0;
+	for (int type = 0; type < NUM_HAND_TYPES; ++type)
+		sum += count[type];
+	return sum;
+}
+
+/*
+* Purpose: Get how many of the ten hand-types have been drawn at least once
+* Parameters: None
+* Returns: Int
+*/
+int HandCounts::typesSeen() const {
+	int seen = 0;
+	for (int type = 0; type < NUM_HAND_TYPES; ++type)
+		if (count[type] > 0)
+			++seen;
+	return seen;
+}
+
+/*
+* Purpose: Add the counts of another set of counts to these
+* Parameters: HandCounts
+* Returns: None
+*/
+void HandCounts::add(const HandCounts& other) {
+	for (int type = 0; type < NUM_HAND_TYPES; ++type)
+		count[type] += other.count[type];
+}
+
+/*
+* Purpose: Set every count back to 0
+* Parameters: None
+* Returns: None
+*/
+void HandCounts::clear() {
+	count.fill(0);
+}
@@ -0,0 +1,41 @@
+#if !defined(__HANDCOUNTS_H__)
+#define __HANDCOUNTS_H__
+/*
+* Program: PokerHandFrequencies
+* Module: HandCounts.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Number of hands drawn of each hand-type. The counters are a fixed array
+*      indexed by HandType and are 64-bit so long runs cannot overflow them.
+*/
+
+#include <array>
+#include <cstdint>
+
+#include "HandEvaluator.h"
+
+struct HandCounts {
+
+	//Constructor
+	HandCounts() {
+		count.fill(0);
+	}
+
+	inline uint64_t& operator[](HandType type) {
+		return count[type];
+	}
+
+	inline uint64_t operator[](HandType type) const {
+		return count[type];
+	}
+
+	//Public Methods
+	uint64_t total() const;
+	int typesSeen() const;
+	void add(const HandCounts& other);
+	void clear();
+
+	//Member Variables
+	std::array<uint64_t, NUM_HAND_TYPES> count;
+};
+#endif
@@ -0,0 +1,100 @@
+/*
+* Program: PokerHandFrequencies
+* Module: HandEnumerator.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Walks the 2,598,960 5-card hands (or the 133,784,560 7-card hands) in colexicographic order.
+*/
+
+#include "HandEnumerator.h"
+
+/*
+* Purpose: Binomial coefficient C(n, k), 0 when k > n
+* Parameters: Int n, Int k
+* Returns: uint64_t
+*/
+uint64_t HandEnumerator::_choose(int n, int k) {
+	if (k < 0 || k > n)
+		return 0;
+	uint64_t result = 1;
+	for (int i = 1; i <= k; ++i)
+		result = result * (n - k + i) / i;
+	return result;
+}
+
+/*
+* Purpose: Count the ways to choose k of n things
+* Parameters: Int n, Int k at most n
+* Returns: uint64_t
+*/
+uint64_t HandEnumerator::combinations(int n, int k) {
+	return _choose(n, k);
+}
+
+/*
+* Purpose: Get the hand at an index of the colex order
+* Parameters: uint64_t index below the number of hands, Int array filled with ascending cards, Int number of cards
+* Returns: None
+*/
+void HandEnumerator::unrank(uint64_t index, int hand[], int numCards) {
+	int card = 51;
+	for (int k = numCards; k >= 1; --k) {
+		// The largest card whose C(card, k) still fits in what is left of the index
+		while (_choose(card, k) > index)
+			--card;
+		hand[k - 1] = card;
+		index -= _choose(card, k);
+		--card;
+	}
+}
+
+/*
+* Purpose: Split the indices 0 - total into contiguous ranges of near equal size
+* Parameters: uint64_t total, Int parts, Int part, uint64_t begin and end set to the range of part
+* Returns: None
+*/
+void HandEnumerator::splitRange(uint64_t total, int parts, int part, uint64_t& begin, uint64_t& end) {
+	uint64_t size = total / parts, extra = total % parts;
+	begin = part * size + (part < (int)extra ? part : extra);
+	end = begin + size + (part < (int)extra ? 1 : 0);
+}
+
+/*
+* Purpose: Classify every hand in a range of the colex order and add them to counts
+* Parameters: HandEvaluator, uint64_t begin, uint64_t end, HandCounts
+* Returns: None
+*/
+void HandEnumerator::countRange(const HandEvaluator& evaluator, uint64_t begin, uint64_t end, HandCounts& counts) {
+	if (begin >= end)
+		return;
+
+	int hand[5];
+	unrank(begin, hand);
+	for (uint64_t index = begin; index < end; ++index) {
+		++counts[evaluator.classify(hand)];
+		next(hand);
+	}
+}
+
+/*
+* Purpose: Find the best 5 cards of every 7-card hand in a range of the colex order and add them to counts
+* Parameters: SevenCardEvaluator, uint64_t begin, uint64_t end, HandCounts
+* Returns: None
+*/
+void HandEnumerator::countSevenCardRange(const SevenCardEvaluator& evaluator, uint64_t begin, uint64_t end, HandCounts& counts) {
+	if (begin >= end)
+		return;
+
+	HandMask cardMasks[DECK_SIZE];
+	for (int card = 0; card < DECK_SIZE; ++card)
+		cardMasks[card] = cardMask(cardFromIndex(card));
+
+	int hand[7];
+	unrank(begin, hand, 7);
+	for (uint64_t index = begin; index < end; ++index) {
+		HandMask mask = cardMasks[hand[0]] | cardMasks[hand[1]] | cardMasks[hand[2]] | cardMasks[hand[3]]
+			| cardMasks[hand[4]] | cardMasks[hand[5]] | cardMasks[hand[6]];
+		++counts[evaluator.classify(mask)];
+		next(hand, 7);
+	}
+}
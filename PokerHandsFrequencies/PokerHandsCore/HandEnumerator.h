@@ -0,0 +1,49 @@
+#if !defined(__HANDENUMERATOR_H__)
+#define __HANDENUMERATOR_H__
+/*
+* Program: PokerHandFrequencies
+* Module: HandEnumerator.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Walks the 2,598,960 5-card hands (or the 133,784,560 7-card hands) in
+*      colexicographic order. Hand i is the combination c0 < c1 < c2 < c3 < c4 with
+*      i = C(c0,1) + C(c1,2) + C(c2,3) + C(c3,4) + C(c4,5) (the combinatorial number
+*      system, with two more terms for 7 cards), so any contiguous range of indices can
+*      be handed to a rank or thread and started without walking the hands before it.
+*/
+
+#include <cstdint>
+
+#include "HandCounts.h"
+#include "HandEvaluator.h"
+#include "SevenCardEvaluator.h"
+
+class HandEnumerator {
+public:
+
+	// Public static methods
+	static void unrank(uint64_t index, int hand[], int numCards = 5);
+	static uint64_t combinations(int n, int k);
+	static void splitRange(uint64_t total, int parts, int part, uint64_t& begin, uint64_t& end);
+	static void countRange(const HandEvaluator& evaluator, uint64_t begin, uint64_t end, HandCounts& counts);
+	static void countSevenCardRange(const SevenCardEvaluator& evaluator, uint64_t begin, uint64_t end, HandCounts& counts);
+
+	/*
+	* Purpose: Move a hand to the next hand in colex order
+	* Parameters: Int array of ascending cards, Int number of cards
+	* Returns: None
+	*/
+	static inline void next(int hand[], int numCards = 5) {
+		// Find the lowest card that can move up, resetting the cards below it to their smallest values
+		int i = 0;
+		while (i < numCards - 1 && hand[i] + 1 == hand[i + 1]) {
+			hand[i] = i;
+			++i;
+		}
+		++hand[i];
+	}
+
+private:
+	static uint64_t _choose(int n, int k);
+};
+#endif
@@ -0,0 +1,104 @@
+/*
+* Program: PokerHandFrequencies
+* Module: HandEvaluator.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Table driven 5-card hand classifier shared by the serial and parallel
+*      programs. See HandEvaluator.h for the card numbering.
+*/
+
+#include "HandEvaluator.h"
+
+//Globals
+bool HandEvaluator::_tablesBuilt = false;
+HandEvaluator::CardEntry HandEvaluator::_cardTable[52];
+unsigned char HandEvaluator::_handTable[1 << 13][4];
+
+//Const
+// Rank bits of 10, J, Q, K and A
+const unsigned ROYAL_RANKS = 0x1E01;
+
+//Constructor
+HandEvaluator::HandEvaluator(){
+	if (!_tablesBuilt)
+		_buildTables();
+}
+
+//Deconstructor
+HandEvaluator::~HandEvaluator(){
+}
+
+/*
+* Purpose: Count the ranks present in a rank mask
+* Parameters: Unsigned rank mask
+* Returns: Int
+*/
+int countRanks(unsigned ranks) {
+	int count = 0;
+	for (; ranks; ranks &= ranks - 1)
+		++count;
+	return count;
+}
+
+/*
+* Purpose: Check if a mask of 5 ranks is a straight, aces are low (A,2,3,4,5) or high (10,J,Q,K,A)
+* Parameters: Unsigned rank mask
+* Returns: bool
+*/
+bool isStraightRanks(unsigned ranks) {
+	if (ranks == ROYAL_RANKS)
+		return true;
+	for (int low = 0; low + 5 <= 13; ++low) {
+		if (ranks == (0x1Fu << low))
+			return true;
+	}
+	return false;
+}
+
+/*
+* Purpose: Fill in the card and hand tables. The hand table is indexed by the rank mask of a hand
+*		   and a column: 0 - 2 for hands without a flush (0 no triple or quadruple, 1 triple,
+*		   2 quadruple) and 3 for a flush.
+* Parameters: void
+* Returns: None
+*/
+void HandEvaluator::_buildTables(void) {
+	for (int card = 0; card < 52; ++card) {
+		int rank = card % 13;
+		_cardTable[card].rankCount = 1ULL << (4 * rank);
+		_cardTable[card].rankBit = (unsigned short)(1 << rank);
+		_cardTable[card].suitBit = (unsigned char)(1 << (card / 13));
+	}
+
+	for (unsigned ranks = 0; ranks < (1 << 13); ++ranks) {
+		unsigned char* row = _handTable[ranks];
+		for (int column = 0; column < 4; ++column)
+			row[column] = NO_PAIR;
+
+		switch (countRanks(ranks)) {
+		case 5:
+			// No pairs, so only the straight and flush checks remain
+			if (isStraightRanks(ranks)) {
+				row[0] = STRAIGHT;
+				row[FLUSH_COLUMN] = (ranks == ROYAL_RANKS) ? ROYAL_FLUSH : STRAIGHT_FLUSH;
+			}
+			else {
+				row[FLUSH_COLUMN] = FLUSH;
+			}
+			break;
+		case 4:
+			row[0] = ONE_PAIR;
+			break;
+		case 3:
+			row[0] = TWO_PAIR;
+			row[1] = THREE_OF_A_KIND;
+			break;
+		case 2:
+			row[1] = FULL_HOUSE;
+			row[2] = FOUR_OF_A_KIND;
+			break;
+		}
+	}
+
+	_tablesBuilt = true;
+}
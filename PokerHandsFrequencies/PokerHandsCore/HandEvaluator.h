@@ -0,0 +1,109 @@
+#if !defined(__HANDEVALUATOR_H__)
+#define __HANDEVALUATOR_H__
+/*
+* Program: PokerHandFrequencies
+* Module: HandEvaluator.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Table driven 5-card hand classifier shared by the serial and parallel
+*      programs. Cards are numbered 0 - 51 where rank = card % 13 (0 is the ace) and
+*      suit = card / 13. All of the rank and suit arithmetic is done once when the
+*      tables are built, so classifying a hand is a handful of loads and bitwise
+*      operations with no sorting, no divisions and no data dependent branches.
+*      Dealt hands are classified from their 64-bit card mask instead (see Card.h).
+*/
+
+#include <cstdint>
+
+#include "Card.h"
+
+// The ten hand-types, ordered from weakest to strongest
+enum HandType {
+	NO_PAIR,
+	ONE_PAIR,
+	TWO_PAIR,
+	THREE_OF_A_KIND,
+	STRAIGHT,
+	FLUSH,
+	FULL_HOUSE,
+	FOUR_OF_A_KIND,
+	STRAIGHT_FLUSH,
+	ROYAL_FLUSH,
+	NUM_HAND_TYPES
+};
+
+class HandEvaluator {
+public:
+
+	//Constructor/Deconstructor
+	HandEvaluator();
+	~HandEvaluator();
+
+	/*
+	* Purpose: Classify a hand of 5 distinct cards
+	* Parameters: Int array of 5 cards numbered 0 - 51
+	* Returns: The hand-type of the hand
+	*/
+	inline HandType classify(const int hand[5]) const {
+		const CardEntry& c0 = _cardTable[hand[0]];
+		const CardEntry& c1 = _cardTable[hand[1]];
+		const CardEntry& c2 = _cardTable[hand[2]];
+		const CardEntry& c3 = _cardTable[hand[3]];
+		const CardEntry& c4 = _cardTable[hand[4]];
+
+		// One bit per rank present, and a bit left in suits only when every card shares a suit
+		unsigned ranks = c0.rankBit | c1.rankBit | c2.rankBit | c3.rankBit | c4.rankBit;
+		unsigned suits = c0.suitBit & c1.suitBit & c2.suitBit & c3.suitBit & c4.suitBit;
+
+		// A 4-bit count per rank. A count of 3 is the only one with its two low bits set
+		// and a count of 4 is the only one with bit 2 set.
+		uint64_t counts = c0.rankCount + c1.rankCount + c2.rankCount + c3.rankCount + c4.rankCount;
+		unsigned column = ((counts & (counts >> 1) & TRIPS_MASK) != 0)
+			| (((counts & QUADS_MASK) != 0) << 1)
+			| ((suits != 0) * FLUSH_COLUMN);
+
+		return (HandType)_handTable[ranks][column];
+	}
+
+	/*
+	* Purpose: Classify a hand of 5 distinct cards from its card mask, with bitwise operations on
+	*		   the rank mask of each suit. A rank held in all four suits is a quadruple, one held in
+	*		   three of them a triple, and the hand is a flush when the other three suits are empty.
+	* Parameters: HandMask of 5 cards
+	* Returns: The hand-type of the hand
+	*/
+	inline HandType classifyMask(HandMask hand) const {
+		unsigned s0 = suitRanks(hand, 0), s1 = suitRanks(hand, 1), s2 = suitRanks(hand, 2), s3 = suitRanks(hand, 3);
+		unsigned ranks = s0 | s1 | s2 | s3;
+		unsigned quads = s0 & s1 & s2 & s3;
+		unsigned trips = ((s0 & s1 & (s2 | s3)) | (s2 & s3 & (s0 | s1))) & ~quads;
+		unsigned flush = ((s1 | s2 | s3) == 0) | ((s0 | s2 | s3) == 0) | ((s0 | s1 | s3) == 0) | ((s0 | s1 | s2) == 0);
+		unsigned column = (trips != 0) | ((quads != 0) << 1) | (flush * FLUSH_COLUMN);
+
+		return (HandType)_handTable[ranks][column];
+	}
+
+private:
+	// The batch classifier reads the same tables
+	friend class BatchClassifier;
+
+	// Per card values looked up while classifying
+	struct CardEntry {
+		uint64_t rankCount;
+		unsigned short rankBit;
+		unsigned char suitBit;
+	};
+
+	static const uint64_t TRIPS_MASK = 0x1111111111111ULL;
+	static const uint64_t QUADS_MASK = 0x4444444444444ULL;
+	static const unsigned FLUSH_COLUMN = 3;
+
+	// Private static method
+	static void _buildTables(void);
+
+	// Shared lookup tables, built once by the first evaluator constructed
+	static bool _tablesBuilt;
+	static CardEntry _cardTable[52];
+	static unsigned char _handTable[1 << 13][4];
+};
+#endif
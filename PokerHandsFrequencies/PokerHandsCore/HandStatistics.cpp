@@ -0,0 +1,235 @@
+/*
+* Program: PokerHandFrequencies
+* Module: HandStatistics.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Exact 5 and 7-card hand-type counts and a chi-square goodness of fit check
+*      of simulated counts against them.
+*/
+
+#include <cmath>
+#include <limits>
+
+#include "HandStatistics.h"
+
+using namespace std;
+
+//Const
+// Number of hands of each type out of the 2,598,960, indexed by HandType
+const uint64_t EXACT_COUNTS[NUM_HAND_TYPES] = {
+	1302540,	// No Pair
+	1098240,	// One Pair
+	123552,		// Two Pair
+	54912,		// Three of a Kind
+	10200,		// Straight
+	5108,		// Flush
+	3744,		// Full House
+	624,		// Four of a Kind
+	36,			// Straight Flush
+	4			// Royal Flush
+};
+
+// Number of 7-card hands whose best 5 cards are of each type out of the 133,784,560, indexed by HandType
+const uint64_t EXACT_SEVEN_CARD_COUNTS[NUM_HAND_TYPES] = {
+	23294460,	// No Pair
+	58627800,	// One Pair
+	31433400,	// Two Pair
+	6461620,	// Three of a Kind
+	6180020,	// Straight
+	4047644,	// Flush
+	3473184,	// Full House
+	224848,		// Four of a Kind
+	37260,		// Straight Flush
+	4324		// Royal Flush
+};
+
+// Chi-square critical values at p = 0.001 for 1 to 9 degrees of freedom
+const double CHI_SQUARE_CRITICAL[NUM_HAND_TYPES] = {
+	0.0, 10.828, 13.816, 16.266, 18.467, 20.515, 22.458, 24.322, 26.124, 27.877
+};
+
+// Smallest expected count a chi-square category may have
+const double MIN_EXPECTED = 5.0;
+
+// Normal quantile of a two-sided 95% interval
+const double Z_95 = 1.959964;
+
+/*
+* Purpose: Get the number of distinct hands of 5 or 7 cards
+* Parameters: Int cards per hand
+* Returns: uint64_t
+*/
+uint64_t HandStatistics::totalHands(int cardsPerHand) {
+	return (cardsPerHand == 7) ? TOTAL_SEVEN_CARD_HANDS : TOTAL_HANDS;
+}
+
+/*
+* Purpose: Get the number of the 2,598,960 5-card hands, or of the 133,784,560 7-card hands, that are of a hand-type
+* Parameters: HandType, Int cards per hand
+* Returns: uint64_t
+*/
+uint64_t HandStatistics::exactCount(HandType type, int cardsPerHand) {
+	return (cardsPerHand == 7) ? EXACT_SEVEN_CARD_COUNTS[type] : EXACT_COUNTS[type];
+}
+
+/*
+* Purpose: Get the probability of drawing a hand-type
+* Parameters: HandType, Int cards per hand
+* Returns: double
+*/
+double HandStatistics::exactFrequency(HandType type, int cardsPerHand) {
+	return (double)exactCount(type, cardsPerHand) / totalHands(cardsPerHand);
+}
+
+/*
+* Purpose: Pearson's chi-square statistic of simulated counts against the exact frequencies.
+*		   The rarest hand-types are pooled, strongest first, until each category expects
+*		   at least 5 hands.
+* Parameters: HandCounts, Int degreesOfFreedom set to the number of categories - 1, Int cards per hand
+* Returns: double
+*/
+double HandStatistics::chiSquare(const HandCounts& counts, int& degreesOfFreedom, int cardsPerHand) {
+	uint64_t total = counts.total();
+
+	double statistic = 0.0;
+	double pooledObserved = 0.0, pooledExpected = 0.0;
+	int categories = 0;
+	for (int type = NUM_HAND_TYPES - 1; type >= 0; --type) {
+		pooledObserved += (double)counts[(HandType)type];
+		pooledExpected += exactFrequency((HandType)type, cardsPerHand) * total;
+		if (pooledExpected >= MIN_EXPECTED || type == 0) {
+			double diff = pooledObserved - pooledExpected;
+			statistic += diff * diff / pooledExpected;
+			++categories;
+			pooledObserved = pooledExpected = 0.0;
+		}
+	}
+
+	degreesOfFreedom = categories - 1;
+	return statistic;
+}
+
+/*
+* Purpose: Check simulated counts are consistent with the exact frequencies at the 0.1% level
+* Parameters: HandCounts, Int cards per hand
+* Returns: bool - true if the counts pass
+*/
+bool HandStatistics::passesChiSquare(const HandCounts& counts, int cardsPerHand) {
+	int degreesOfFreedom;
+	double statistic = chiSquare(counts, degreesOfFreedom, cardsPerHand);
+	if (degreesOfFreedom < 1)
+		return false;
+	return statistic < CHI_SQUARE_CRITICAL[degreesOfFreedom];
+}
+
+/*
+* Purpose: Pearson's chi-square statistic of two sets of simulated counts against each other (a test
+*		   of homogeneity), e.g. counts drawn from the multinomial against counts of dealt hands. The
+*		   expected counts of each set come from the two sets together, and the rarest hand-types are
+*		   pooled, strongest first, until each category expects at least 5 hands in both sets.
+* Parameters: HandCounts first and second, Int degreesOfFreedom set to the number of categories - 1
+* Returns: double
+*/
+double HandStatistics::homogeneityChiSquare(const HandCounts& first, const HandCounts& second, int& degreesOfFreedom) {
+	double firstTotal = (double)first.total(), secondTotal = (double)second.total();
+	double total = firstTotal + secondTotal;
+
+	double statistic = 0.0;
+	double pooledFirst = 0.0, pooledSecond = 0.0;
+	int categories = 0;
+	for (int type = NUM_HAND_TYPES - 1; type >= 0; --type) {
+		pooledFirst += (double)first[(HandType)type];
+		pooledSecond += (double)second[(HandType)type];
+		double expectedFirst = (pooledFirst + pooledSecond) * firstTotal / total;
+		double expectedSecond = (pooledFirst + pooledSecond) * secondTotal / total;
+		if ((expectedFirst >= MIN_EXPECTED && expectedSecond >= MIN_EXPECTED) || type == 0) {
+			if (expectedFirst > 0.0 && expectedSecond > 0.0) {
+				statistic += (pooledFirst - expectedFirst) * (pooledFirst - expectedFirst) / expectedFirst;
+				statistic += (pooledSecond - expectedSecond) * (pooledSecond - expectedSecond) / expectedSecond;
+				++categories;
+			}
+			pooledFirst = pooledSecond = 0.0;
+		}
+	}
+
+	degreesOfFreedom = categories - 1;
+	return statistic;
+}
+
+/*
+* Purpose: Check two sets of simulated counts are consistent with the same frequencies at the 0.1% level
+* Parameters: HandCounts first and second
+* Returns: bool - true if the counts pass
+*/
+bool HandStatistics::passesHomogeneity(const HandCounts& first, const HandCounts& second) {
+	int degreesOfFreedom;
+	double statistic = homogeneityChiSquare(first, second, degreesOfFreedom);
+	if (degreesOfFreedom < 1)
+		return false;
+	return statistic < CHI_SQUARE_CRITICAL[degreesOfFreedom];
+}
+
+/*
+* Purpose: Check counts of every 5-card hand are exactly the known counts (4 royal flushes,
+*		   36 straight flushes, ...), used to check the enumeration and the classifier
+* Parameters: HandCounts, Int cards per hand
+* Returns: bool - true if every count is exact
+*/
+bool HandStatistics::matchesExact(const HandCounts& counts, int cardsPerHand) {
+	for (int type = 0; type < NUM_HAND_TYPES; ++type)
+		if (counts[(HandType)type] != exactCount((HandType)type, cardsPerHand))
+			return false;
+	return true;
+}
+
+/*
+* Purpose: 95% Wilson score interval for the relative frequency of a hand-type. Unlike the
+*		   normal approximation it stays inside 0 - 1 and is sensible for the rare hand-types.
+* Parameters: uint64_t count of the hand-type, uint64_t total hands, double low and high set to the interval
+* Returns: None
+*/
+void HandStatistics::wilsonInterval(uint64_t count, uint64_t total, double& low, double& high) {
+	if (total == 0) {
+		low = 0.0;
+		high = 1.0;
+		return;
+	}
+	double n = (double)total;
+	double p = count / n;
+	double z2 = Z_95 * Z_95;
+	double denominator = 1.0 + z2 / n;
+	double center = (p + z2 / (2.0 * n)) / denominator;
+	double halfWidth = Z_95 * sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n)) / denominator;
+	low = center - halfWidth;
+	high = center + halfWidth;
+}
+
+/*
+* Purpose: Half the width of the 95% Wilson interval of a hand-type, relative to its observed
+*		   frequency. 0.01 means the frequency is known to within about 1% of itself.
+* Parameters: uint64_t count of the hand-type, uint64_t total hands
+* Returns: double - infinity while the hand-type has not been seen
+*/
+double HandStatistics::relativeHalfWidth(uint64_t count, uint64_t total) {
+	if (count == 0)
+		return numeric_limits<double>::infinity();
+	double low, high;
+	wilsonInterval(count, total, low, high);
+	return (high - low) / 2.0 / ((double)count / total);
+}
+
+/*
+* Purpose: The largest relative half width of any hand-type, see relativeHalfWidth()
+* Parameters: HandCounts
+* Returns: double
+*/
+double HandStatistics::worstRelativeHalfWidth(const HandCounts& counts) {
+	uint64_t total = counts.total();
+	double worst = 0.0;
+	for (int type = 0; type < NUM_HAND_TYPES; ++type) {
+		double width = relativeHalfWidth(counts[(HandType)type], total);
+		if (width > worst)
+			worst = width;
+	}
+	return worst;
+}
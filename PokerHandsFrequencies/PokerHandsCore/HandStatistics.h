@@ -0,0 +1,41 @@
+#if !defined(__HANDSTATISTICS_H__)
+#define __HANDSTATISTICS_H__
+/*
+* Program: PokerHandFrequencies
+* Module: HandStatistics.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Exact 5-card hand-type counts (out of the 2,598,960 possible hands, see
+*      http://en.wikipedia.org/wiki/Poker_probability#Frequency_of_5-card_poker_hands),
+*      exact counts of the best 5 cards of the 133,784,560 7-card hands, and a chi-square
+*      goodness of fit check of simulated counts against them, or of two sets of simulated
+*      counts against each other. Also 95% Wilson score intervals for the relative frequency
+*      of each hand-type in simulated counts.
+*/
+
+#include <cstdint>
+
+#include "HandCounts.h"
+#include "HandEvaluator.h"
+
+class HandStatistics {
+public:
+
+	// Number of distinct 5-card hands, C(52,5), and 7-card hands, C(52,7)
+	static const uint64_t TOTAL_HANDS = 2598960;
+	static const uint64_t TOTAL_SEVEN_CARD_HANDS = 133784560;
+
+	// Public static methods
+	static uint64_t totalHands(int cardsPerHand = 5);
+	static uint64_t exactCount(HandType type, int cardsPerHand = 5);
+	static double exactFrequency(HandType type, int cardsPerHand = 5);
+	static double chiSquare(const HandCounts& counts, int& degreesOfFreedom, int cardsPerHand = 5);
+	static bool passesChiSquare(const HandCounts& counts, int cardsPerHand = 5);
+	static double homogeneityChiSquare(const HandCounts& first, const HandCounts& second, int& degreesOfFreedom);
+	static bool passesHomogeneity(const HandCounts& first, const HandCounts& second);
+	static bool matchesExact(const HandCounts& counts, int cardsPerHand = 5);
+	static void wilsonInterval(uint64_t count, uint64_t total, double& low, double& high);
+	static double relativeHalfWidth(uint64_t count, uint64_t total);
+	static double worstRelativeHalfWidth(const HandCounts& counts);
+};
+#endif
@@ -0,0 +1,315 @@
+/*
+* Program: PokerHandFrequencies
+* Module: HandTables.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Builds, writes and memory maps the precomputed tables. See HandTables.h.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "EquityCalculator.h"
+#include "HandEnumerator.h"
+#include "HandStatistics.h"
+#include "HandTables.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+//Const
+const char TABLE_MAGIC[8] = { 'P', 'H', 'F', 'T', 'A', 'B', 'L', 'E' };
+// Changes whenever the layout or the meaning of a table changes
+const uint32_t TABLE_VERSION = 1;
+// Reads back as 0x04030201 on a machine of the other byte order
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+const uint64_t TABLE_ALIGNMENT = 64;
+const char HIGH_RANK_NAMES[] = "23456789TJQKA";
+
+/*
+* Purpose: Round a file offset up to the next table boundary
+* Parameters: uint64_t offset
+* Returns: uint64_t
+*/
+static uint64_t alignOffset(uint64_t offset) {
+	return (offset + TABLE_ALIGNMENT - 1) / TABLE_ALIGNMENT * TABLE_ALIGNMENT;
+}
+
+/*
+* Purpose: Get the rank of a card counting up from the 2 (0) to the ace (12)
+* Parameters: Card
+* Returns: Int
+*/
+static int highRank(Card card) {
+	return (cardRank(card) + RANKS_PER_SUIT - 1) % RANKS_PER_SUIT;
+}
+
+//Constructor
+HandTables::HandTables(){
+	_view = 0;
+	_size = 0;
+	_ranks = 0;
+	_preflop = 0;
+}
+
+//Deconstructor
+HandTables::~HandTables(){
+	close();
+}
+
+/*
+* Purpose: Map a table file into memory read only and check its header. The tables are used in place.
+* Parameters: string path, string set to what is wrong
+* Returns: bool - false if the file can not be mapped or is not a table file of this version
+*/
+bool HandTables::open(const string& path, string& error) {
+	close();
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	if (file == INVALID_HANDLE_VALUE) {
+		error = "can not open " + path;
+		return false;
+	}
+	LARGE_INTEGER size;
+	GetFileSizeEx(file, &size);
+	HANDLE mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+	// The view keeps the file mapped after the handles are closed
+	_view = mapping ? (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : 0;
+	if (mapping)
+		CloseHandle(mapping);
+	CloseHandle(file);
+	_size = (uint64_t)size.QuadPart;
+#else
+	int file = ::open(path.c_str(), O_RDONLY);
+	if (file < 0) {
+		error = "can not open " + path;
+		return false;
+	}
+	struct stat status;
+	fstat(file, &status);
+	_size = (uint64_t)status.st_size;
+	void* view = (_size > 0) ? mmap(0, _size, PROT_READ, MAP_SHARED, file, 0) : MAP_FAILED;
+	// The mapping stays after the file is closed
+	::close(file);
+	_view = (view == MAP_FAILED) ? 0 : (const unsigned char*)view;
+#endif
+	if (!_view) {
+		error = "can not map " + path;
+		return false;
+	}
+
+	const TableHeader* header = (const TableHeader*)_view;
+	if (_size < sizeof(TableHeader) || memcmp(header->magic, TABLE_MAGIC, sizeof(TABLE_MAGIC)) != 0)
+		error = path + " is not a table file";
+	else if (header->byteOrder != BYTE_ORDER_MARK)
+		error = path + " was written on a machine of the other byte order";
+	else if (header->version != TABLE_VERSION)
+		error = path + " is from another version, run PokerHandsTables again";
+	else if (header->rankCount != HandStatistics::totalHands(5) || header->equityCount != STARTING_HANDS
+		|| header->rankOffset % TABLE_ALIGNMENT != 0 || header->equityOffset % TABLE_ALIGNMENT != 0
+		|| header->rankOffset + header->rankCount * sizeof(HandStrength) > _size
+		|| header->equityOffset + header->equityCount * sizeof(PreflopEquity) > _size)
+		error = path + " is cut short or damaged";
+	if (!error.empty()) {
+		close();
+		return false;
+	}
+
+	_ranks = (const HandStrength*)(_view + header->rankOffset);
+	_preflop = (const PreflopEquity*)(_view + header->equityOffset);
+	return true;
+}
+
+/*
+* Purpose: Unmap the table file, if one is open
+* Parameters: None
+* Returns: None
+*/
+void HandTables::close() {
+	if (_view) {
+#if defined(_WIN32)
+		UnmapViewOfFile(_view);
+#else
+		munmap((void*)_view, _size);
+#endif
+	}
+	_view = 0;
+	_size = 0;
+	_ranks = 0;
+	_preflop = 0;
+}
+
+/*
+* Purpose: Check if a table file is open
+* Parameters: None
+* Returns: bool
+*/
+bool HandTables::isOpen() const {
+	return _view != 0;
+}
+
+/*
+* Purpose: Check the checksum of the open file against its header. Reads the whole file.
+* Parameters: None
+* Returns: bool - true if the tables are as they were written
+*/
+bool HandTables::verify() const {
+	if (!_view)
+		return false;
+	const TableHeader* header = (const TableHeader*)_view;
+	return checksum(_view + sizeof(TableHeader), _size - sizeof(TableHeader)) == header->checksum;
+}
+
+/*
+* Purpose: Get the seed the equity table was made with
+* Parameters: None
+* Returns: uint64_t
+*/
+uint64_t HandTables::seed() const {
+	return ((const TableHeader*)_view)->seed;
+}
+
+/*
+* Purpose: Count the hand-types of a range of the 5-card hands from the strength table
+* Parameters: uint64_t begin, uint64_t end, HandCounts to add to
+* Returns: None
+*/
+void HandTables::countRange(uint64_t begin, uint64_t end, HandCounts& counts) const {
+	for (uint64_t index = begin; index < end; ++index)
+		++counts[SevenCardEvaluator::strengthType(_ranks[index])];
+}
+
+/*
+* Purpose: Build both tables and write them to a file. The equities come from random boards against a
+*		   random hand, dealt on the threads of the pool until each is within the options' tolerance.
+* Parameters: string path, SimulationOptions, WorkerPool, string set to what went wrong
+* Returns: bool - false if the file can not be written
+*/
+bool HandTables::generate(const string& path, const SimulationOptions& options, WorkerPool& pool, string& error) {
+	uint64_t numHands = HandStatistics::totalHands(5);
+	uint64_t rankOffset = alignOffset(sizeof(TableHeader));
+	uint64_t equityOffset = alignOffset(rankOffset + numHands * sizeof(HandStrength));
+	uint64_t size = equityOffset + STARTING_HANDS * sizeof(PreflopEquity);
+	vector<unsigned char> image((size_t)size, 0);
+
+	SevenCardEvaluator evaluator;
+	HandStrength* ranks = (HandStrength*)&image[(size_t)rankOffset];
+	int hand[5];
+	HandEnumerator::unrank(0, hand);
+	for (uint64_t index = 0; index < numHands; ++index) {
+		HandMask cards = 0;
+		for (int i = 0; i < 5; ++i)
+			cards |= cardMask(cardFromIndex(hand[i]));
+		ranks[index] = evaluator.strength(cards);
+		HandEnumerator::next(hand);
+	}
+
+	vector<Matchup> matchups(STARTING_HANDS);
+	for (int start = 0; start < STARTING_HANDS; ++start) {
+		matchups[start].players.push_back(startingHandCards(start));
+		matchups[start].players.push_back(0);
+		matchups[start].playerNames.push_back(startingHandName(start));
+		matchups[start].playerNames.push_back("random");
+		matchups[start].randomPlayers = 1;
+	}
+	vector<EquityTally> tallies(STARTING_HANDS);
+	EquityCalculator::calculateAll(pool, options, 0, 1, matchups, tallies);
+	PreflopEquity* preflop = (PreflopEquity*)&image[(size_t)equityOffset];
+	for (int start = 0; start < STARTING_HANDS; ++start) {
+		preflop[start].equity = tallies[start].equity(0);
+		preflop[start].win = tallies[start].wins[0] / tallies[start].boards;
+		preflop[start].tie = tallies[start].ties[0] / tallies[start].boards;
+	}
+
+	TableHeader* header = (TableHeader*)&image[0];
+	memcpy(header->magic, TABLE_MAGIC, sizeof(TABLE_MAGIC));
+	header->version = TABLE_VERSION;
+	header->byteOrder = BYTE_ORDER_MARK;
+	header->rankOffset = rankOffset;
+	header->rankCount = numHands;
+	header->equityOffset = equityOffset;
+	header->equityCount = STARTING_HANDS;
+	header->seed = options.seed;
+	header->checksum = checksum(&image[sizeof(TableHeader)], size - sizeof(TableHeader));
+
+	ofstream file(path.c_str(), ios::binary | ios::trunc);
+	file.write((const char*)&image[0], (streamsize)size);
+	if (!file) {
+		error = "can not write " + path;
+		return false;
+	}
+	return true;
+}
+
+/*
+* Purpose: Get the starting hand (0 - 168) of two hole cards. The hands are a 13 x 13 grid of ranks from
+*		   the 2 up to the ace: pairs on the diagonal, suited hands with the higher rank as the row and
+*		   off-suit hands with the higher rank as the column.
+* Parameters: HandMask of the two hole cards
+* Returns: Int
+*/
+int HandTables::startingHand(HandMask holeCards) {
+	Card cards[2];
+	int found = 0;
+	for (int index = 0; index < DECK_SIZE && found < 2; ++index)
+		if (holeCards & cardMask(cardFromIndex(index)))
+			cards[found++] = cardFromIndex(index);
+
+	int high = max(highRank(cards[0]), highRank(cards[1]));
+	int low = min(highRank(cards[0]), highRank(cards[1]));
+	if (cardSuit(cards[0]) == cardSuit(cards[1]))
+		return high * RANKS_PER_SUIT + low;
+	return low * RANKS_PER_SUIT + high;
+}
+
+/*
+* Purpose: Get two hole cards of a starting hand, spades and hearts (or two spades if it is suited)
+* Parameters: Int starting hand
+* Returns: HandMask
+*/
+HandMask HandTables::startingHandCards(int hand) {
+	int row = hand / RANKS_PER_SUIT, column = hand % RANKS_PER_SUIT;
+	int high = max(row, column), low = min(row, column);
+	int secondSuit = (row > column) ? 0 : 1;
+	return cardMask(makeCard((high + 1) % RANKS_PER_SUIT, 0)) | cardMask(makeCard((low + 1) % RANKS_PER_SUIT, secondSuit));
+}
+
+/*
+* Purpose: Get the name of a starting hand, e.g. "AA", "AKs" or "AKo"
+* Parameters: Int starting hand
+* Returns: string
+*/
+string HandTables::startingHandName(int hand) {
+	int row = hand / RANKS_PER_SUIT, column = hand % RANKS_PER_SUIT;
+	string name;
+	name += HIGH_RANK_NAMES[max(row, column)];
+	name += HIGH_RANK_NAMES[min(row, column)];
+	if (row != column)
+		name += (row > column) ? 's' : 'o';
+	return name;
+}
+
+/*
+* Purpose: 64-bit FNV-1a hash of a block of bytes
+* Parameters: unsigned char pointer, uint64_t size
+* Returns: uint64_t
+*/
+uint64_t HandTables::checksum(const unsigned char* bytes, uint64_t size) {
+	uint64_t hash = 14695981039346656037ULL;
+	for (uint64_t i = 0; i < size; ++i) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
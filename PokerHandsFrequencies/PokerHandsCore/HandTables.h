@@ -0,0 +1,101 @@
+#if !defined(__HANDTABLES_H__)
+#define __HANDTABLES_H__
+/*
+* Program: PokerHandFrequencies
+* Module: HandTables.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Tables built once by PokerHandsTables and memory mapped by the other programs
+*      instead of being worked out again on every run:
+*      - the strength (SevenCardEvaluator::strength) of every one of the 2,598,960 5-card
+*        hands, in the colex order of HandEnumerator, 4 bytes each
+*      - the equity, win and tie rates of each of the 169 starting hands of Texas Hold'em
+*        (AA, AKs, AKo, ...) against one random hand, by EquityCalculator
+*      The file is a 64-byte header followed by the tables, each starting on a 64-byte
+*      boundary, so both are read straight from the mapped pages with no copy. The header
+*      holds a magic string, a format version, a byte order mark and a checksum (64-bit
+*      FNV-1a) of everything after it. open() checks the header and the file size only, which
+*      takes microseconds; verify() reads every byte to check the checksum.
+*/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Card.h"
+#include "HandCounts.h"
+#include "SevenCardEvaluator.h"
+#include "SimulationOptions.h"
+#include "WorkerPool.h"
+
+//Const
+static const int STARTING_HANDS = 169;
+
+// One starting hand against a random hand, each a fraction of the boards
+struct PreflopEquity {
+	double equity;
+	double win;
+	double tie;
+};
+
+// The start of a table file. Every field is a fixed size and the file is little-endian.
+struct TableHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	uint64_t checksum;
+	uint64_t rankOffset;
+	uint64_t rankCount;
+	uint64_t equityOffset;
+	uint64_t equityCount;
+	uint64_t seed;
+};
+
+class HandTables {
+public:
+
+	//Constructor/Deconstructor
+	HandTables();
+	~HandTables();
+
+	//Public Methods
+	bool open(const std::string& path, std::string& error);
+	void close();
+	bool isOpen() const;
+	bool verify() const;
+	uint64_t seed() const;
+	void countRange(uint64_t begin, uint64_t end, HandCounts& counts) const;
+
+	/*
+	* Purpose: Get the strength of a 5-card hand from the table
+	* Parameters: uint64_t colex index of the hand (see HandEnumerator)
+	* Returns: HandStrength
+	*/
+	inline HandStrength rank(uint64_t index) const {
+		return _ranks[index];
+	}
+
+	/*
+	* Purpose: Get a starting hand's equity against a random hand from the table
+	* Parameters: Int starting hand, see startingHand()
+	* Returns: PreflopEquity
+	*/
+	inline const PreflopEquity& preflop(int hand) const {
+		return _preflop[hand];
+	}
+
+	// Public static methods
+	static bool generate(const std::string& path, const SimulationOptions& options, WorkerPool& pool, std::string& error);
+	static int startingHand(HandMask holeCards);
+	static HandMask startingHandCards(int hand);
+	static std::string startingHandName(int hand);
+	static uint64_t checksum(const unsigned char* bytes, uint64_t size);
+
+private:
+	//Member Variables
+	const unsigned char* _view;
+	uint64_t _size;
+	const HandStrength* _ranks;
+	const PreflopEquity* _preflop;
+};
+#endif
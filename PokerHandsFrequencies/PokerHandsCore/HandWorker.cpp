@@ -0,0 +1,299 @@
+/*
+* Program: PokerHandFrequencies
+* Module: HandWorker.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Deals and counts the hands of one thread. See HandWorker.h.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+
+#include "Checkpoint.h"
+#include "HandEnumerator.h"
+#include "HandWorker.h"
+
+using namespace std;
+
+//Const
+// Hands taken at a time by a thread when enumerating, small enough for the threads to finish together
+const uint64_t ENUMERATE_CHUNK = 1 << 16;
+
+//Constructor
+HandWorker::HandWorker(const SimulationOptions& options, int rank, int thread){
+	// A run resumed from a checkpoint takes the streams of its own segment
+	_random.seed(options.generator, options.seed, rank, options.segment * SEGMENT_STREAMS + thread);
+	_cardsPerHand = options.cardsPerHand;
+	_reproducible = options.reproducible;
+	_handRandom.seed(options.seed);
+	_nextIndex = 0;
+	uintptr_t line = ((uintptr_t)_deckLine + CACHE_LINE_SIZE - 1) & ~(uintptr_t)(CACHE_LINE_SIZE - 1);
+	_deck = (Card*)line;
+	for (int i = 0; i < DECK_SIZE; ++i)
+		_deck[i] = cardFromIndex(i);
+	for (int type = 0; type < NUM_HAND_TYPES; ++type)
+		_published[type].store(0);
+}
+
+//Deconstructor
+HandWorker::~HandWorker(){
+}
+
+/*
+* Purpose: Swap two cards of the deck
+* Parameters: Card pointer to ls, rs
+* Returns: None
+*/
+static void swapCards(Card *ls, Card *rs)
+{
+	Card temp = *ls;
+	*ls = *rs;
+	*rs = temp;
+}
+
+/*
+* Purpose: Deals a hand with a partial Fisher-Yates shuffle. Each of the 5 (or 7) cards is swapped
+*		   to the front from the cards not yet dealt, so only one random number is drawn per card and
+*		   the deck stays a full permutation for the next hand.
+* Parameters: None
+* Returns: None
+*/
+void HandWorker::_dealHand() {
+	for (int i = 0; i < _cardsPerHand; ++i) {
+		//pick a random index from i - 51
+		int j = i + _random.nextBelow(DECK_SIZE - i);
+
+		//Swap deck[i] with the element at random index and deal it
+		swapCards(&_deck[i], &_deck[j]);
+		_hand[i] = _deck[i];
+	}
+}
+
+/*
+* Purpose: Deals the hand of index _nextIndex of a --reproducible run from its own random numbers,
+*		   then undoes the swaps in reverse so the deck is back in order. The hand then depends only
+*		   on the seed and its index, not on the hands dealt before it.
+* Parameters: None
+* Returns: None
+*/
+void HandWorker::_dealIndexedHand() {
+	int picked[MAX_HAND_CARDS];
+	_handRandom.start(_nextIndex++);
+	for (int i = 0; i < _cardsPerHand; ++i) {
+		picked[i] = i + _handRandom.nextBelow(DECK_SIZE - i);
+		swapCards(&_deck[i], &_deck[picked[i]]);
+		_hand[i] = _deck[i];
+	}
+	for (int i = _cardsPerHand - 1; i >= 0; --i)
+		swapCards(&_deck[i], &_deck[picked[i]]);
+}
+
+/*
+* Purpose: Deals a batch of hands and classifies them together. 7-card hands are dealt into card
+*		   masks first, then each is classified from its mask.
+* Parameters: Int number of hands, at most HandBatch::SIZE. ByIndex deals them by their index
+*			  (_dealIndexedHand) rather than from this thread's stream.
+* Returns: None
+*/
+template <bool ByIndex>
+void HandWorker::_dealBatch(int size) {
+	_batch.size = size;
+	PHASE_START(mark);
+	if (_cardsPerHand == 7) {
+		HandMask masks[HandBatch::SIZE];
+		for (int i = 0; i < size; ++i) {
+			if (ByIndex)
+				_dealIndexedHand();
+			else
+				_dealHand();
+			masks[i] = handMask(_hand, 7);
+		}
+		PHASE_LAP(_phases, PHASE_DEAL, mark);
+		for (int i = 0; i < size; ++i)
+			_batch.types[i] = (unsigned char)_sevenCardEvaluator.classify(masks[i]);
+		PHASE_STOP(_phases, PHASE_CLASSIFY, mark);
+		return;
+	}
+
+	for (int i = 0; i < size; ++i) {
+		if (ByIndex)
+			_dealIndexedHand();
+		else
+			_dealHand();
+		_batch.set(i, _hand);
+	}
+	PHASE_LAP(_phases, PHASE_DEAL, mark);
+	_classifier.classify(_batch);
+	PHASE_STOP(_phases, PHASE_CLASSIFY, mark);
+}
+
+/*
+* Purpose: Deal and count hands until every hand-type has been found by one of the threads. The
+*		   thread that finds the last hand-type stops at that hand; the others finish their batch.
+* Parameters: atomic mask of the hand-types found by all of the threads, one bit per HandType
+* Returns: None
+*/
+void HandWorker::drawUntilAllFound(atomic<unsigned>& typesSeen) {
+	while (typesSeen.load(memory_order_relaxed) != ALL_TYPES_SEEN) {
+		_dealBatch<false>(HandBatch::SIZE);
+		PHASE_START(mark);
+		for (int i = 0; i < _batch.size; ++i) {
+			HandType type = (HandType)_batch.types[i];
+			// Only the first of each hand-type in this thread touches the shared mask
+			if (++_counts[type] == 1) {
+				unsigned bit = 1u << type;
+				if ((typesSeen.fetch_or(bit) | bit) == ALL_TYPES_SEEN) {
+					PHASE_STOP(_phases, PHASE_TALLY, mark);
+					return;
+				}
+			}
+		}
+		PHASE_STOP(_phases, PHASE_TALLY, mark);
+	}
+}
+
+/*
+* Purpose: Deal and count a batch of hands, adding any hand-type this thread has not seen before to
+*		   the shared mask
+* Parameters: atomic mask of the hand-types found by all of the threads, one bit per HandType
+* Returns: None
+*/
+void HandWorker::drawBatch(atomic<unsigned>& typesSeen) {
+	_dealBatch<false>(HandBatch::SIZE);
+	PHASE_START(mark);
+	for (int i = 0; i < _batch.size; ++i) {
+		HandType type = (HandType)_batch.types[i];
+		if (++_counts[type] == 1)
+			typesSeen.fetch_or(1u << type);
+	}
+
+	for (int type = 0; type < NUM_HAND_TYPES; ++type)
+		_published[type].store(_counts[(HandType)type], memory_order_relaxed);
+	PHASE_STOP(_phases, PHASE_TALLY, mark);
+}
+
+/*
+* Purpose: Deal and count batches of hands until another thread says to stop
+* Parameters: atomic mask of the hand-types found by all of the threads, atomic stop flag
+* Returns: None
+*/
+void HandWorker::drawUntilStopped(atomic<unsigned>& typesSeen, const atomic<bool>& stop) {
+	while (!stop.load(memory_order_relaxed))
+		drawBatch(typesSeen);
+}
+
+/*
+* Purpose: Deal and count a number of hands
+* Parameters: uint64_t numHands
+* Returns: None
+*/
+void HandWorker::drawHands(uint64_t numHands) {
+	for (uint64_t n = 0; n < numHands; n += _batch.size) {
+		_dealBatch<false>((int)min<uint64_t>(numHands - n, HandBatch::SIZE));
+		_countBatch();
+	}
+}
+
+/*
+* Purpose: Deal and count the hands of a range of a run. A --reproducible run deals each hand from
+*		   its index, so the counts of a run are the same however its ranges are split between
+*		   processes and threads; otherwise it is drawHands with the range's number of hands.
+* Parameters: uint64_t begin, end of the range of hand indices
+* Returns: None
+*/
+void HandWorker::drawRange(uint64_t begin, uint64_t end) {
+	if (!_reproducible) {
+		drawHands(end - begin);
+		return;
+	}
+	// Each hand is dealt from the deck in order
+	for (int i = 0; i < DECK_SIZE; ++i)
+		_deck[i] = cardFromIndex(i);
+	_nextIndex = begin;
+	for (uint64_t n = begin; n < end; n += _batch.size) {
+		_dealBatch<true>((int)min<uint64_t>(end - n, HandBatch::SIZE));
+		_countBatch();
+	}
+}
+
+/*
+* Purpose: Add the hand-types of the batch just dealt to the counts
+* Parameters: None
+* Returns: None
+*/
+void HandWorker::_countBatch() {
+	PHASE_START(mark);
+	for (int i = 0; i < _batch.size; ++i)
+		++_counts[(HandType)_batch.types[i]];
+	PHASE_STOP(_phases, PHASE_TALLY, mark);
+}
+
+/*
+* Purpose: Count the hands of a range of the colex order, taking chunks of it until none are left.
+*		   A thread that finishes its chunks early takes more, so the threads finish together.
+* Parameters: atomic index of the next chunk shared by the threads, uint64_t end of the range
+* Returns: None
+*/
+void HandWorker::enumerate(atomic<uint64_t>& nextChunk, uint64_t end) {
+	for (;;) {
+		uint64_t begin = nextChunk.fetch_add(ENUMERATE_CHUNK);
+		if (begin >= end)
+			return;
+		// Walking the hands in order is all classifying, there is nothing to deal
+		PHASE_START(mark);
+		if (_cardsPerHand == 7)
+			HandEnumerator::countSevenCardRange(_sevenCardEvaluator, begin, min(begin + ENUMERATE_CHUNK, end), _counts);
+		else
+			HandEnumerator::countRange(_evaluator, begin, min(begin + ENUMERATE_CHUNK, end), _counts);
+		PHASE_STOP(_phases, PHASE_CLASSIFY, mark);
+	}
+}
+
+/*
+* Purpose: Get the hand-type counts of this thread
+* Parameters: None
+* Returns: HandCounts
+*/
+const HandCounts& HandWorker::counts() const {
+	return _counts;
+}
+
+/*
+* Purpose: Add the counts this thread published after its last batch to a total. Safe to call
+*		   from another thread while this one deals.
+* Parameters: HandCounts total
+* Returns: None
+*/
+void HandWorker::addPublishedCounts(HandCounts& total) const {
+	for (int type = 0; type < NUM_HAND_TYPES; ++type)
+		total[(HandType)type] += _published[type].load(memory_order_relaxed);
+}
+
+/*
+* Purpose: Get the cycles this thread spent in each phase, as of its last batch
+* Parameters: None
+* Returns: PhaseTimes
+*/
+const PhaseTimes& HandWorker::phases() const {
+	return _phases;
+}
+
+/*
+* Purpose: Get the instruction set the batch classifier uses
+* Parameters: None
+* Returns: SimdLevel
+*/
+SimdLevel HandWorker::classifierLevel() const {
+	return _classifier.level();
+}
+
+/*
+* Purpose: Get the number of threads the machine can run at once, 1 when it is not known
+* Parameters: None
+* Returns: Int
+*/
+int HandWorker::hardwareThreads() {
+	unsigned threads = thread::hardware_concurrency();
+	return threads == 0 ? 1 : (int)threads;
+}
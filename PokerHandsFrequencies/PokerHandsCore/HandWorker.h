@@ -0,0 +1,82 @@
+#if !defined(__HANDWORKER_H__)
+#define __HANDWORKER_H__
+/*
+* Program: PokerHandFrequencies
+* Module: HandWorker.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Everything one thread needs to deal and count hands on its own: a deck, a random
+*      number stream, a batch classifier (or, for 7-card hands, the 7-card evaluator) and
+*      hand-type counts. Threads only share the "types seen" mask (one bit per hand-type), a
+*      copy of their counts published after each batch and, when enumerating, the index of the
+*      next chunk of hands. Each worker is allocated on its own and padded on both sides so the
+*      counts of two threads never sit in the same cache line.
+*/
+
+#include <atomic>
+#include <cstdint>
+
+#include "BatchClassifier.h"
+#include "HandCounts.h"
+#include "PhaseTimer.h"
+#include "Random.h"
+#include "SevenCardEvaluator.h"
+#include "SimulationOptions.h"
+
+//Const
+static const int CACHE_LINE_SIZE = 64;
+static const unsigned ALL_TYPES_SEEN = (1u << NUM_HAND_TYPES) - 1;
+static const int MAX_HAND_CARDS = 7;
+
+class HandWorker {
+public:
+
+	//Constructor/Deconstructor
+	HandWorker(const SimulationOptions& options, int rank, int thread);
+	~HandWorker();
+
+	//Public Methods
+	void drawUntilAllFound(std::atomic<unsigned>& typesSeen);
+	void drawUntilStopped(std::atomic<unsigned>& typesSeen, const std::atomic<bool>& stop);
+	void drawBatch(std::atomic<unsigned>& typesSeen);
+	void drawHands(uint64_t numHands);
+	void drawRange(uint64_t begin, uint64_t end);
+	void enumerate(std::atomic<uint64_t>& nextChunk, uint64_t end);
+	const HandCounts& counts() const;
+	void addPublishedCounts(HandCounts& total) const;
+	const PhaseTimes& phases() const;
+	SimdLevel classifierLevel() const;
+
+	// Public static method
+	static int hardwareThreads();
+
+private:
+	void _dealHand();
+	void _dealIndexedHand();
+	template <bool ByIndex> void _dealBatch(int size);
+	void _countBatch();
+
+	//Member Variables
+	char _padBefore[CACHE_LINE_SIZE];
+	HandCounts _counts;
+	// A copy of the counts other threads may read while this one deals, updated after each batch
+	std::atomic<uint64_t> _published[NUM_HAND_TYPES];
+	// The deck is the first cache line boundary in _deckLine, so its 52 card bytes are one cache line
+	Card _deckLine[2 * CACHE_LINE_SIZE];
+	Card* _deck;
+	Card _hand[MAX_HAND_CARDS];
+	int _cardsPerHand;
+	RandomStream _random;
+	// A --reproducible run deals each hand of a range from its index, the next one being _nextIndex
+	bool _reproducible;
+	HandRandom _handRandom;
+	uint64_t _nextIndex;
+	HandEvaluator _evaluator;
+	SevenCardEvaluator _sevenCardEvaluator;
+	BatchClassifier _classifier;
+	HandBatch _batch;
+	// Cycles spent in each phase, only added to when built with PHF_PHASE_TIMING
+	PhaseTimes _phases;
+	char _padAfter[CACHE_LINE_SIZE];
+};
+#endif
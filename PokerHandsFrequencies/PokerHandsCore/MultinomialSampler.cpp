@@ -0,0 +1,161 @@
+/*
+* Program: PokerHandFrequencies
+* Module: MultinomialSampler.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Draws hand-type counts from their exact multinomial distribution. See MultinomialSampler.h.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "HandStatistics.h"
+#include "MultinomialSampler.h"
+
+using namespace std;
+
+//Const
+// Below this many expected successes a binomial is drawn by inversion
+const double INVERSION_LIMIT = 10.0;
+
+// log(k!) - (k + 0.5) log(k + 1) + (k + 1) - log(sqrt(2 pi)) for k = 0 - 9, the error of Stirling's formula
+const double STIRLING_TAIL[10] = {
+	0.0810614667953272, 0.0413406959554092, 0.0276779256849983, 0.02079067210376509, 0.0166446911898211,
+	0.0138761288230707, 0.0118967099458917, 0.0104112652619720, 0.00925546218271273, 0.00833056343336287
+};
+
+//Constructor
+MultinomialSampler::MultinomialSampler(const SimulationOptions& options, int rank){
+	// The stream after the last worker thread's, so validation deals from different numbers
+	_random.seed(options.generator, options.seed, rank, options.threads);
+	_cardsPerHand = options.cardsPerHand;
+}
+
+//Deconstructor
+MultinomialSampler::~MultinomialSampler(){
+}
+
+/*
+* Purpose: Draw the hand-type counts of a number of random hands. The strongest (and rarest) hand-types
+*		   are drawn first; each takes a binomial share of the hands left with its exact probability among the
+*		   hand-types not drawn yet, and No Pair gets the hands that remain.
+* Parameters: uint64_t numHands
+* Returns: HandCounts
+*/
+HandCounts MultinomialSampler::sample(uint64_t numHands) {
+	HandCounts counts;
+	uint64_t handsLeft = numHands;
+	uint64_t combinationsLeft = HandStatistics::totalHands(_cardsPerHand);
+	for (int type = NUM_HAND_TYPES - 1; type > 0 && handsLeft > 0; --type) {
+		uint64_t combinations = HandStatistics::exactCount((HandType)type, _cardsPerHand);
+		uint64_t drawn = binomial(_random, handsLeft, (double)combinations / combinationsLeft);
+		counts.count[type] = drawn;
+		handsLeft -= drawn;
+		combinationsLeft -= combinations;
+	}
+	counts.count[NO_PAIR] += handsLeft;
+	return counts;
+}
+
+/*
+* Purpose: Draw the number of successes in a number of trials that each succeed with probability p
+* Parameters: RandomStream, uint64_t trials, double p
+* Returns: uint64_t - between 0 and trials
+*/
+uint64_t MultinomialSampler::binomial(RandomStream& random, uint64_t trials, double p) {
+	if (trials == 0 || p <= 0.0)
+		return 0;
+	if (p >= 1.0)
+		return trials;
+	// Both methods want p at most one half, count the failures instead
+	if (p > 0.5)
+		return trials - binomial(random, trials, 1.0 - p);
+	if (trials * p < INVERSION_LIMIT)
+		return _binomialInversion(random, trials, p);
+	return _binomialRejection(random, trials, p);
+}
+
+/*
+* Purpose: Binomial by inversion: walk up the probabilities of 0, 1, 2, ... successes until they
+*		   pass a uniform number. Takes about trials * p steps, so only used when that is small.
+* Parameters: RandomStream, uint64_t trials, double p at most 0.5
+* Returns: uint64_t
+*/
+uint64_t MultinomialSampler::_binomialInversion(RandomStream& random, uint64_t trials, double p) {
+	double n = (double)trials;
+	double q = 1.0 - p;
+	double probabilityOfNone = exp(n * log1p(-p));
+	// Far enough into the tail that getting there means rounding ran the walk off, so start again
+	double bound = min(n, n * p + 10.0 * sqrt(n * p * q + 1.0));
+
+	uint64_t successes = 0;
+	double probability = probabilityOfNone;
+	double u = random.nextDouble();
+	while (u > probability) {
+		++successes;
+		if (successes > bound) {
+			successes = 0;
+			probability = probabilityOfNone;
+			u = random.nextDouble();
+		}
+		else {
+			u -= probability;
+			probability *= (n - successes + 1.0) * p / (successes * q);
+		}
+	}
+	return successes;
+}
+
+/*
+* Purpose: Binomial by transformed rejection with squeeze (BTRS), W. Hormann, "The generation of
+*		   binomial random variates", 1993. Most draws are accepted by the squeeze with two uniform
+*		   numbers and no logarithm. The exact test compares log probabilities relative to the mode
+*		   using Stirling's formula, which keeps its precision for any number of trials.
+* Parameters: RandomStream, uint64_t trials, double p at most 0.5 with trials * p at least 10
+* Returns: uint64_t
+*/
+uint64_t MultinomialSampler::_binomialRejection(RandomStream& random, uint64_t trials, double p) {
+	double n = (double)trials;
+	double q = 1.0 - p;
+	double spq = sqrt(n * p * q);
+	double b = 1.15 + 2.53 * spq;
+	double a = -0.0873 + 0.0248 * b + 0.01 * p;
+	double c = n * p + 0.5;
+	double vr = 0.92 - 4.2 / b;
+	double alpha = (2.83 + 5.1 / b) * spq;
+	double r = p / q;
+	double m = floor((n + 1.0) * p);
+
+	for (;;) {
+		double u = random.nextDouble() - 0.5;
+		double v = random.nextDouble();
+		double us = 0.5 - fabs(u);
+		double k = floor((2.0 * a / us + b) * u + c);
+		if (k < 0.0 || k > n)
+			continue;
+		if (us >= 0.07 && v <= vr)
+			return (uint64_t)k;
+
+		// log(f(k) / f(m)) of the binomial probabilities f
+		v = log(v * alpha / (a / (us * us) + b));
+		double bound = (m + 0.5) * log((m + 1.0) / (r * (n - m + 1.0)))
+			+ (n + 1.0) * log1p((k - m) / (n - k + 1.0))
+			+ (k + 0.5) * log(r * (n - k + 1.0) / (k + 1.0))
+			+ _stirlingTail(m) + _stirlingTail(n - m) - _stirlingTail(k) - _stirlingTail(n - k);
+		if (v <= bound)
+			return (uint64_t)k;
+	}
+}
+
+/*
+* Purpose: The error of Stirling's formula for log(k!), from the table below 10 and its series above
+* Parameters: double k, a whole number
+* Returns: double
+*/
+double MultinomialSampler::_stirlingTail(double k) {
+	if (k <= 9.0)
+		return STIRLING_TAIL[(int)k];
+	double kp1 = k + 1.0;
+	double kp1sq = kp1 * kp1;
+	return (1.0 / 12 - (1.0 / 360 - 1.0 / 1260 / kp1sq) / kp1sq) / kp1;
+}
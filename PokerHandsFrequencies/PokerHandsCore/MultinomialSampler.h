@@ -0,0 +1,47 @@
+#if !defined(__MULTINOMIALSAMPLER_H__)
+#define __MULTINOMIALSAMPLER_H__
+/*
+* Program: PokerHandFrequencies
+* Module: MultinomialSampler.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Draws the hand-type counts of N random hands straight from their exact
+*      multinomial distribution, without dealing a single hand. The counts are a chain of
+*      binomials: each hand-type takes a binomial share of the hands not yet given to the
+*      hand-types before it, with its probability among the hands that are left. A binomial
+*      is drawn by inversion when few successes are expected and by Hormann's transformed
+*      rejection (BTRS) otherwise, so a sample takes the same few microseconds for a thousand
+*      hands or a trillion. The binomials are our own rather than std::binomial_distribution
+*      so a seed gives the same counts with every compiler.
+*/
+
+#include <cstdint>
+
+#include "HandCounts.h"
+#include "Random.h"
+#include "SimulationOptions.h"
+
+class MultinomialSampler {
+public:
+
+	//Constructor/Deconstructor
+	MultinomialSampler(const SimulationOptions& options, int rank);
+	~MultinomialSampler();
+
+	//Public Methods
+	HandCounts sample(uint64_t numHands);
+
+	// Public static method
+	static uint64_t binomial(RandomStream& random, uint64_t trials, double p);
+
+private:
+	// Private static methods
+	static uint64_t _binomialInversion(RandomStream& random, uint64_t trials, double p);
+	static uint64_t _binomialRejection(RandomStream& random, uint64_t trials, double p);
+	static double _stirlingTail(double k);
+
+	//Member Variables
+	RandomStream _random;
+	int _cardsPerHand;
+};
+#endif
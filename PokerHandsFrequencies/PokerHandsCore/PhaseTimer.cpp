@@ -0,0 +1,127 @@
+/*
+* Program: PokerHandFrequencies
+* Module: PhaseTimer.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Wall clock and per-phase timing of a run. See PhaseTimer.h.
+*/
+
+#include "PhaseTimer.h"
+
+using namespace std;
+
+//Const
+// How long the cycle counter is compared with the steady_clock to find its rate
+const double CALIBRATION_SECONDS = 0.02;
+
+/*
+* Purpose: Set every phase back to 0 cycles
+* Parameters: None
+* Returns: None
+*/
+void PhaseTimes::clear() {
+	for (int phase = 0; phase < NUM_PHASES; ++phase)
+		cycles[phase] = 0;
+}
+
+/*
+* Purpose: Add the cycles of another set of phases to these
+* Parameters: PhaseTimes
+* Returns: None
+*/
+void PhaseTimes::add(const PhaseTimes& other) {
+	for (int phase = 0; phase < NUM_PHASES; ++phase)
+		cycles[phase] += other.cycles[phase];
+}
+
+/*
+* Purpose: Get the cycles of every phase added together
+* Parameters: None
+* Returns: uint64_t
+*/
+uint64_t PhaseTimes::total() const {
+	uint64_t sum = 0;
+	for (int phase = 0; phase < NUM_PHASES; ++phase)
+		sum += cycles[phase];
+	return sum;
+}
+
+//Constructor
+Stopwatch::Stopwatch(){
+	restart();
+}
+
+//Deconstructor
+Stopwatch::~Stopwatch(){
+}
+
+/*
+* Purpose: Start timing again from now
+* Parameters: None
+* Returns: None
+*/
+void Stopwatch::restart() {
+	_start = chrono::steady_clock::now();
+}
+
+/*
+* Purpose: Get the wall clock time since the stopwatch was started
+* Parameters: None
+* Returns: double seconds
+*/
+double Stopwatch::elapsed() const {
+	return chrono::duration<double>(chrono::steady_clock::now() - _start).count();
+}
+
+/*
+* Purpose: Check if the programs were built to time the phases (PHF_PHASE_TIMING)
+* Parameters: None
+* Returns: bool
+*/
+bool PhaseTimer::enabled() {
+#if defined(PHF_PHASE_TIMING)
+	return true;
+#else
+	return false;
+#endif
+}
+
+/*
+* Purpose: Get how fast the cycle counter counts, measured the first time it is asked for
+* Parameters: None
+* Returns: double cycles per second
+*/
+double PhaseTimer::cyclesPerSecond() {
+	static const double rate = _measureRate();
+	return rate;
+}
+
+/*
+* Purpose: Time the time stamp counter against the steady_clock. The fallback counter already
+*		   counts nanoseconds.
+* Parameters: None
+* Returns: double cycles per second
+*/
+double PhaseTimer::_measureRate() {
+#if defined(PHASE_TSC)
+	Stopwatch timer;
+	uint64_t start = now();
+	double seconds;
+	do {
+		seconds = timer.elapsed();
+	} while (seconds < CALIBRATION_SECONDS);
+	return (now() - start) / seconds;
+#else
+	return 1e9;
+#endif
+}
+
+/*
+* Purpose: Get the name of a phase as it is shown in reports
+* Parameters: Phase
+* Returns: const char pointer
+*/
+const char* PhaseTimer::phaseName(Phase phase) {
+	static const char* names[NUM_PHASES] = { "Deal", "Classify", "Tally", "MPI Wait" };
+	return names[phase];
+}
@@ -0,0 +1,110 @@
+#if !defined(__PHASETIMER_H__)
+#define __PHASETIMER_H__
+/*
+* Program: PokerHandFrequencies
+* Module: PhaseTimer.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Timing of a run. Stopwatch measures wall clock time on the monotonic
+*      steady_clock, which the reports' elapsed times come from. When the programs are built with
+*      PHF_PHASE_TIMING defined, each thread also adds up the cycles it spends in each phase of
+*      dealing: dealing the cards, classifying the hands, tallying the counts and, in the
+*      parallel program, the main thread's MPI calls. A phase is timed by reading the CPU's time
+*      stamp counter (rdtsc; the steady_clock in nanoseconds on other CPUs) before and after a
+*      whole batch of hands, so it costs a few reads per batch rather than per hand. Without
+*      PHF_PHASE_TIMING the PHASE_ macros are empty and nothing is read or added.
+*/
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(PHF_PHASE_TIMING) && (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
+#define PHASE_TSC
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+// The phases the cycles of a thread are split into
+enum Phase {
+	PHASE_DEAL,
+	PHASE_CLASSIFY,
+	PHASE_TALLY,
+	PHASE_MPI_WAIT,
+	NUM_PHASES
+};
+
+// Cycles spent in each phase
+struct PhaseTimes {
+
+	//Constructor
+	PhaseTimes() {
+		clear();
+	}
+
+	//Public Methods
+	void clear();
+	void add(const PhaseTimes& other);
+	uint64_t total() const;
+
+	//Member Variables
+	uint64_t cycles[NUM_PHASES];
+};
+
+class Stopwatch {
+public:
+
+	//Constructor/Deconstructor
+	Stopwatch();
+	~Stopwatch();
+
+	//Public Methods
+	void restart();
+	double elapsed() const;
+
+private:
+	//Member Variables
+	std::chrono::steady_clock::time_point _start;
+};
+
+class PhaseTimer {
+public:
+
+	/*
+	* Purpose: Read the cycle counter
+	* Parameters: None
+	* Returns: uint64_t
+	*/
+	static inline uint64_t now() {
+#if defined(PHASE_TSC)
+		return __rdtsc();
+#else
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+	}
+
+	// Public static methods
+	static bool enabled();
+	static double cyclesPerSecond();
+	static const char* phaseName(Phase phase);
+
+private:
+	// Private static method
+	static double _measureRate();
+};
+
+#if defined(PHF_PHASE_TIMING)
+// Start timing a phase from here
+#define PHASE_START(mark) uint64_t mark = PhaseTimer::now()
+// Add the cycles since the mark to a phase and start the next phase from here
+#define PHASE_LAP(times, phase, mark) do { uint64_t lap = PhaseTimer::now(); (times).cycles[phase] += lap - (mark); (mark) = lap; } while (0)
+// Add the cycles since the mark to a phase
+#define PHASE_STOP(times, phase, mark) ((times).cycles[phase] += PhaseTimer::now() - (mark))
+#else
+#define PHASE_START(mark)
+#define PHASE_LAP(times, phase, mark)
+#define PHASE_STOP(times, phase, mark)
+#endif
+#endif
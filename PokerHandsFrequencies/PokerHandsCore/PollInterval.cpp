@@ -0,0 +1,65 @@
+/*
+* Program: PokerHandFrequencies
+* Module: PollInterval.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Sizes the blocks of batches dealt between quit checks. See PollInterval.h.
+*/
+
+#include <algorithm>
+
+#include "PollInterval.h"
+
+using namespace std;
+
+//Const
+// A block is never more than this many batches, however fast the process deals
+const int MAX_POLL_BATCHES = 1 << 16;
+// Weight of the newest block in the smoothed rate
+const double RATE_WEIGHT = 0.25;
+
+//Constructor
+PollInterval::PollInterval(double targetSeconds){
+	_targetSeconds = targetSeconds;
+	_rate = 0;
+	// The rate is unknown until the first block, so it is a single batch
+	_batches = 1;
+}
+
+//Deconstructor
+PollInterval::~PollInterval(){
+}
+
+/*
+* Purpose: Get how many batches to deal before the next check
+* Parameters: None
+* Returns: Int
+*/
+int PollInterval::batches() const {
+	return _batches;
+}
+
+/*
+* Purpose: Take in how long the last block took and size the next one to take the target time.
+*		   The first block sets the rate; later ones are smoothed into it so one slow block (the
+*		   process descheduled, say) does not halve the block size.
+* Parameters: Int batches dealt in the block, double seconds from the check before it to the end
+*			  of the check after it
+* Returns: None
+*/
+void PollInterval::update(int batches, double seconds) {
+	if (seconds <= 0)
+		return;
+	double rate = batches / seconds;
+	_rate = (_rate == 0) ? rate : (1 - RATE_WEIGHT) * _rate + RATE_WEIGHT * rate;
+	_batches = (int)min<double>(max<double>(_targetSeconds * _rate, 1), MAX_POLL_BATCHES);
+}
+
+/*
+* Purpose: Get the time a block is sized to take
+* Parameters: None
+* Returns: double seconds
+*/
+double PollInterval::targetSeconds() const {
+	return _targetSeconds;
+}
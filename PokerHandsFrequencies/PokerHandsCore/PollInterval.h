@@ -0,0 +1,34 @@
+#if !defined(__POLLINTERVAL_H__)
+#define __POLLINTERVAL_H__
+/*
+* Program: PokerHandFrequencies
+* Module: PollInterval.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: How many batches of hands a process deals between checks for the master's
+*      quit. Checking costs MPI calls, so a process deals a block of batches between checks,
+*      sized from its measured rate so a block takes about the target time (--poll-us). That
+*      target bounds how long after the quit a process keeps dealing. Knows nothing of MPI;
+*      the caller times each block and passes the time in.
+*/
+
+class PollInterval {
+public:
+
+	//Constructor/Deconstructor
+	PollInterval(double targetSeconds);
+	~PollInterval();
+
+	//Public Methods
+	int batches() const;
+	void update(int batches, double seconds);
+	double targetSeconds() const;
+
+private:
+	//Member Variables
+	double _targetSeconds;
+	// Batches dealt per second, smoothed over the blocks so far (0 until the first block)
+	double _rate;
+	int _batches;
+};
+#endif
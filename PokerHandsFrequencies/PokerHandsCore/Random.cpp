@@ -0,0 +1,342 @@
+/*
+* Program: PokerHandFrequencies
+* Module: Random.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Pseudo random number generators used to deal hands. See Random.h for how
+*      the streams of different ranks and threads are kept apart.
+*/
+
+#include <chrono>
+#include <random>
+
+#include "Random.h"
+
+using namespace std;
+
+//Const
+// xoshiro256** jump polynomials, equivalent to 2^128 and 2^192 calls to next()
+const uint64_t XOSHIRO_JUMP[4] = {
+	0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+};
+const uint64_t XOSHIRO_LONG_JUMP[4] = {
+	0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL, 0x39109bb02acbe635ULL
+};
+
+// PCG64 LCG multiplier
+const Uint128 PCG_MULTIPLIER = { 0x2360ED051FC65DA4ULL, 0x4385DF649FCCF645ULL };
+
+// Philox4x32 round multipliers and Weyl key increments
+const uint32_t PHILOX_M0 = 0xD2511F53, PHILOX_M1 = 0xCD9E8D57;
+const uint32_t PHILOX_W0 = 0x9E3779B9, PHILOX_W1 = 0xBB67AE85;
+const int PHILOX_ROUNDS = 10;
+
+/*
+* Purpose: SplitMix64 step, used to expand a 64-bit seed into generator state
+* Parameters: uint64_t state, advanced in place
+* Returns: uint64_t
+*/
+uint64_t splitMix64(uint64_t& state) {
+	uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+/*
+* Purpose: Full 128-bit product of two 64-bit numbers
+* Parameters: uint64_t a, b
+* Returns: Uint128
+*/
+Uint128 multiply64(uint64_t a, uint64_t b) {
+	Uint128 result;
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 product = (unsigned __int128)a * b;
+	result.hi = (uint64_t)(product >> 64);
+	result.lo = (uint64_t)product;
+#else
+	uint64_t aLo = a & 0xFFFFFFFF, aHi = a >> 32;
+	uint64_t bLo = b & 0xFFFFFFFF, bHi = b >> 32;
+	uint64_t loLo = aLo * bLo, hiLo = aHi * bLo, loHi = aLo * bHi, hiHi = aHi * bHi;
+	uint64_t cross = (loLo >> 32) + (hiLo & 0xFFFFFFFF) + loHi;
+	result.hi = hiHi + (hiLo >> 32) + (cross >> 32);
+	result.lo = (cross << 32) | (loLo & 0xFFFFFFFF);
+#endif
+	return result;
+}
+
+/*
+* Purpose: 128-bit multiply, modulo 2^128
+* Parameters: Uint128 a, b
+* Returns: Uint128
+*/
+Uint128 multiply128(Uint128 a, Uint128 b) {
+	Uint128 result = multiply64(a.lo, b.lo);
+	result.hi += a.hi * b.lo + a.lo * b.hi;
+	return result;
+}
+
+/*
+* Purpose: 128-bit add, modulo 2^128
+* Parameters: Uint128 a, b
+* Returns: Uint128
+*/
+Uint128 add128(Uint128 a, Uint128 b) {
+	Uint128 result;
+	result.lo = a.lo + b.lo;
+	result.hi = a.hi + b.hi + (result.lo < a.lo);
+	return result;
+}
+
+/*
+* Purpose: Seed xoshiro256** from a 64-bit seed with SplitMix64, as its authors recommend
+* Parameters: uint64_t seed
+* Returns: None
+*/
+void Xoshiro256::seed(uint64_t seed) {
+	for (int i = 0; i < 4; ++i)
+		_s[i] = splitMix64(seed);
+}
+
+void Xoshiro256::jump() {
+	_jump(XOSHIRO_JUMP);
+}
+
+void Xoshiro256::longJump() {
+	_jump(XOSHIRO_LONG_JUMP);
+}
+
+/*
+* Purpose: Advance the state by the jump polynomial in table
+* Parameters: uint64_t array of 4
+* Returns: None
+*/
+void Xoshiro256::_jump(const uint64_t table[4]) {
+	uint64_t s[4] = { 0, 0, 0, 0 };
+	for (int i = 0; i < 4; ++i) {
+		for (int b = 0; b < 64; ++b) {
+			if (table[i] & (1ULL << b)) {
+				for (int w = 0; w < 4; ++w)
+					s[w] ^= _s[w];
+			}
+			next();
+		}
+	}
+	for (int w = 0; w < 4; ++w)
+		_s[w] = s[w];
+}
+
+/*
+* Purpose: Seed PCG64 the way the reference pcg64_srandom_r does
+* Parameters: Uint128 initState, initSequence
+* Returns: None
+*/
+void Pcg64::seed(Uint128 initState, Uint128 initSequence) {
+	_state.hi = _state.lo = 0;
+	_increment.hi = (initSequence.hi << 1) | (initSequence.lo >> 63);
+	_increment.lo = (initSequence.lo << 1) | 1;
+	_step();
+	_state = add128(_state, initState);
+	_step();
+}
+
+void Pcg64::_step() {
+	_state = add128(multiply128(_state, PCG_MULTIPLIER), _increment);
+}
+
+/*
+* Purpose: Jump the LCG ahead by delta steps in O(log delta) (Brown, "Random Number
+*		   Generation with Arbitrary Strides")
+* Parameters: Uint128 delta
+* Returns: None
+*/
+void Pcg64::advance(Uint128 delta) {
+	Uint128 accMult = { 0, 1 }, accPlus = { 0, 0 };
+	Uint128 curMult = PCG_MULTIPLIER, curPlus = _increment;
+	const Uint128 one = { 0, 1 };
+	while (delta.hi || delta.lo) {
+		if (delta.lo & 1) {
+			accMult = multiply128(accMult, curMult);
+			accPlus = add128(multiply128(accPlus, curMult), curPlus);
+		}
+		curPlus = multiply128(add128(curMult, one), curPlus);
+		curMult = multiply128(curMult, curMult);
+		delta.lo = (delta.lo >> 1) | (delta.hi << 63);
+		delta.hi >>= 1;
+	}
+	_state = add128(multiply128(accMult, _state), accPlus);
+}
+
+/*
+* Purpose: Key Philox with the seed and start the stream at block 0 of its rank and thread
+* Parameters: uint64_t key, uint32_t rank, uint32_t thread
+* Returns: None
+*/
+void Philox4x32::seed(uint64_t key, uint32_t rank, uint32_t thread) {
+	_key[0] = (uint32_t)key;
+	_key[1] = (uint32_t)(key >> 32);
+	_counter[0] = 0;
+	_counter[1] = 0;
+	_counter[2] = thread;
+	_counter[3] = rank;
+}
+
+/*
+* Purpose: Philox4x32-10 block function (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3")
+* Parameters: uint32_t counter[4], key[2], out[4]
+* Returns: None
+*/
+void Philox4x32::generate(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]) {
+	uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+	uint32_t k0 = key[0], k1 = key[1];
+	for (int round = 0; round < PHILOX_ROUNDS; ++round) {
+		uint64_t p0 = (uint64_t)PHILOX_M0 * c0;
+		uint64_t p1 = (uint64_t)PHILOX_M1 * c2;
+		uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+		uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+		c1 = (uint32_t)p1;
+		c3 = (uint32_t)p0;
+		c0 = n0;
+		c2 = n2;
+		k0 += PHILOX_W0;
+		k1 += PHILOX_W1;
+	}
+	out[0] = c0;
+	out[1] = c1;
+	out[2] = c2;
+	out[3] = c3;
+}
+
+/*
+* Purpose: Key the hands' numbers with the seed
+* Parameters: uint64_t key
+* Returns: None
+*/
+void HandRandom::seed(uint64_t key) {
+	_key[0] = (uint32_t)key;
+	_key[1] = (uint32_t)(key >> 32);
+	start(0);
+}
+
+//Constructor
+RandomStream::RandomStream(){
+	seed(RNG_XOSHIRO256, 0);
+}
+
+//Deconstructor
+RandomStream::~RandomStream(){
+}
+
+/*
+* Purpose: Select a generator and start the stream belonging to a rank and thread
+* Parameters: RngType type, uint64_t seed, uint32_t rank, uint32_t thread
+* Returns: None
+*/
+void RandomStream::seed(RngType type, uint64_t seed, uint32_t rank, uint32_t thread) {
+	_type = type;
+	switch (type) {
+	case RNG_XOSHIRO256:
+		_xoshiro.seed(seed);
+		for (uint32_t r = 0; r < rank; ++r)
+			_xoshiro.longJump();
+		for (uint32_t t = 0; t < thread; ++t)
+			_xoshiro.jump();
+		break;
+	case RNG_PCG64:
+	{
+		uint64_t state = seed;
+		Uint128 initState, initSequence;
+		initState.hi = splitMix64(state);
+		initState.lo = splitMix64(state);
+		initSequence.hi = splitMix64(state);
+		initSequence.lo = splitMix64(state);
+		_pcg.seed(initState, initSequence);
+		Uint128 delta = { ((uint64_t)rank << 32) | thread, 0 };
+		_pcg.advance(delta);
+		break;
+	}
+	default:
+		_philox.seed(seed, rank, thread);
+		break;
+	}
+	_position = BUFFER_SIZE;
+}
+
+/*
+* Purpose: Fill the buffer from the selected generator. Switching once per buffer keeps the
+*		   choice of generator out of the per-card path.
+* Parameters: void
+* Returns: None
+*/
+void RandomStream::_refill() {
+	switch (_type) {
+	case RNG_XOSHIRO256:
+		for (unsigned i = 0; i < BUFFER_SIZE; i += 2) {
+			uint64_t value = _xoshiro.next();
+			_buffer[i] = (uint32_t)(value >> 32);
+			_buffer[i + 1] = (uint32_t)value;
+		}
+		break;
+	case RNG_PCG64:
+		for (unsigned i = 0; i < BUFFER_SIZE; i += 2) {
+			uint64_t value = _pcg.next();
+			_buffer[i] = (uint32_t)(value >> 32);
+			_buffer[i + 1] = (uint32_t)value;
+		}
+		break;
+	default:
+		for (unsigned i = 0; i < BUFFER_SIZE; i += 4)
+			_philox.next(&_buffer[i]);
+		break;
+	}
+	_position = 0;
+}
+
+/*
+* Purpose: Get the name of a generator
+* Parameters: RngType
+* Returns: const char pointer
+*/
+const char* RandomStream::typeName(RngType type) {
+	static const char* names[NUM_RNG_TYPES] = { "xoshiro256", "pcg64", "philox" };
+	return names[type];
+}
+
+/*
+* Purpose: Look up a generator by name
+* Parameters: string name, RngType type set when found
+* Returns: bool - true if the name is a generator
+*/
+bool RandomStream::parseType(const string& name, RngType& type) {
+	for (int t = 0; t < NUM_RNG_TYPES; ++t) {
+		if (name == typeName((RngType)t)) {
+			type = (RngType)t;
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+* Purpose: Make a seed for a run that was not given one, so every run deals a different
+*		   sequence of hands
+* Parameters: void
+* Returns: uint64_t
+*/
+uint64_t RandomStream::randomSeed(void) {
+	random_device device;
+	uint64_t seed = ((uint64_t)device() << 32) | device();
+	uint64_t ticks = (uint64_t)chrono::high_resolution_clock::now().time_since_epoch().count();
+	return seed ^ splitMix64(ticks);
+}
+
+/*
+* Purpose: Derive the seed of the index-th of many streams from a run's seed in constant time.
+*		   Different indices of one seed always give different seeds.
+* Parameters: uint64_t seed of the run, uint64_t index of the stream
+* Returns: uint64_t
+*/
+uint64_t RandomStream::subSeed(uint64_t seed, uint64_t index) {
+	uint64_t state = splitMix64(seed) ^ index;
+	return splitMix64(state);
+}
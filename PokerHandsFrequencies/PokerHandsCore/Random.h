@@ -0,0 +1,234 @@
+#if !defined(__RANDOM_H__)
+#define __RANDOM_H__
+/*
+* Program: PokerHandFrequencies
+* Module: Random.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Pseudo random number generators used to deal hands. Three generators can be
+*      selected: xoshiro256**, PCG64 (XSL-RR 128/64) and Philox4x32-10. Every stream is
+*      identified by a seed, an MPI rank and a thread, and streams with the same seed are
+*      disjoint by construction:
+*        xoshiro256** - long jump (2^192 steps) once per rank, jump (2^128 steps) once per thread
+*        PCG64        - advanced rank * 2^96 + thread * 2^64 steps
+*        Philox       - the rank and thread are the top two words of the 128-bit counter
+*      A --reproducible run deals each hand from its own Philox counter instead (HandRandom).
+*      Many short streams (one per equity matchup) are each seeded from subSeed instead of
+*      jumping one stream once per index, which costs a jump per stream before it.
+*/
+
+#include <cstdint>
+#include <string>
+
+// The selectable generators
+enum RngType {
+	RNG_XOSHIRO256,
+	RNG_PCG64,
+	RNG_PHILOX,
+	NUM_RNG_TYPES
+};
+
+/*
+* Purpose: Get a uniform random number below a bound from a source of 32 random bits, with Lemire's
+*		   multiply and shift range reduction. The rare low products that would bias the result are
+*		   redrawn, and the division that finds them is only done when a product lands in that range.
+* Parameters: Source with next32(), Int bound
+* Returns: A random int between 0 and bound - 1
+*/
+template <typename Source>
+inline int randomBelow(Source& source, int bound) {
+	uint64_t product = (uint64_t)source.next32() * (uint32_t)bound;
+	uint32_t low = (uint32_t)product;
+	if (low < (uint32_t)bound) {
+		uint32_t threshold = (0u - (uint32_t)bound) % (uint32_t)bound;
+		while (low < threshold) {
+			product = (uint64_t)source.next32() * (uint32_t)bound;
+			low = (uint32_t)product;
+		}
+	}
+	return (int)(product >> 32);
+}
+
+class Xoshiro256 {
+public:
+	void seed(uint64_t seed);
+	void jump();
+	void longJump();
+
+	inline uint64_t next() {
+		const uint64_t result = _rotate(_s[1] * 5, 7) * 9;
+		const uint64_t t = _s[1] << 17;
+		_s[2] ^= _s[0];
+		_s[3] ^= _s[1];
+		_s[1] ^= _s[2];
+		_s[0] ^= _s[3];
+		_s[2] ^= t;
+		_s[3] = _rotate(_s[3], 45);
+		return result;
+	}
+
+private:
+	static inline uint64_t _rotate(uint64_t x, int k) {
+		return (x << k) | (x >> (64 - k));
+	}
+	void _jump(const uint64_t table[4]);
+
+	uint64_t _s[4];
+};
+
+// Unsigned 128-bit integer for the PCG64 state
+struct Uint128 {
+	uint64_t hi;
+	uint64_t lo;
+};
+
+class Pcg64 {
+public:
+	void seed(Uint128 initState, Uint128 initSequence);
+	void advance(Uint128 delta);
+
+	inline uint64_t next() {
+		_step();
+		// XSL-RR output function
+		uint64_t xored = _state.hi ^ _state.lo;
+		unsigned rot = (unsigned)(_state.hi >> 58);
+		return (xored >> rot) | (xored << ((64 - rot) & 63));
+	}
+
+private:
+	void _step();
+
+	Uint128 _state;
+	Uint128 _increment;
+};
+
+class Philox4x32 {
+public:
+	void seed(uint64_t key, uint32_t rank, uint32_t thread);
+
+	// Generate the block for the current counter and move the counter to the next block
+	inline void next(uint32_t out[4]) {
+		generate(_counter, _key, out);
+		if (++_counter[0] == 0)
+			++_counter[1];
+	}
+
+	// Philox4x32-10 block function, counter and key in, 4 random words out
+	static void generate(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]);
+
+private:
+	uint32_t _counter[4];
+	uint32_t _key[2];
+};
+
+// The random numbers of one hand of a --reproducible run: Philox keyed by the seed with the
+// hand's index in the top two words of the counter, so every hand can be dealt on its own and a
+// hand is the same whichever process or thread deals it
+class HandRandom {
+public:
+	void seed(uint64_t key);
+
+	/*
+	* Purpose: Start the numbers of a hand
+	* Parameters: uint64_t index of the hand in the run
+	* Returns: None
+	*/
+	inline void start(uint64_t hand) {
+		_counter[0] = 0;
+		_counter[1] = 0;
+		_counter[2] = (uint32_t)hand;
+		_counter[3] = (uint32_t)(hand >> 32);
+		_position = 4;
+	}
+
+	/*
+	* Purpose: Get the hand's next 32 random bits, generating its next block when the last is used up
+	* Parameters: void
+	* Returns: uint32_t
+	*/
+	inline uint32_t next32() {
+		if (_position == 4) {
+			Philox4x32::generate(_counter, _key, _block);
+			++_counter[0];
+			_position = 0;
+		}
+		return _block[_position++];
+	}
+
+	/*
+	* Purpose: Get a uniform random number below a bound, see randomBelow
+	* Parameters: Int bound
+	* Returns: A random int between 0 and bound - 1
+	*/
+	inline int nextBelow(int bound) {
+		return randomBelow(*this, bound);
+	}
+
+private:
+	uint32_t _counter[4];
+	uint32_t _key[2];
+	uint32_t _block[4];
+	int _position;
+};
+
+class RandomStream {
+public:
+
+	//Constructor/Deconstructor
+	RandomStream();
+	~RandomStream();
+
+	//Public Methods
+	void seed(RngType type, uint64_t seed, uint32_t rank = 0, uint32_t thread = 0);
+	RngType type() const { return _type; }
+
+	/*
+	* Purpose: Get the next 32 random bits, generating a new buffer of them when it runs out
+	* Parameters: void
+	* Returns: uint32_t
+	*/
+	inline uint32_t next32() {
+		if (_position == BUFFER_SIZE)
+			_refill();
+		return _buffer[_position++];
+	}
+
+	/*
+	* Purpose: Get a uniform random number below a bound, see randomBelow
+	* Parameters: Int bound
+	* Returns: A random int between 0 and bound - 1
+	*/
+	inline int nextBelow(int bound) {
+		return randomBelow(*this, bound);
+	}
+
+	/*
+	* Purpose: Get a uniform random number in [0, 1) with 53 random bits, the precision of a double
+	* Parameters: void
+	* Returns: double
+	*/
+	inline double nextDouble() {
+		uint64_t bits = ((uint64_t)next32() << 32) | next32();
+		return (bits >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+	// Public static methods
+	static const char* typeName(RngType type);
+	static bool parseType(const std::string& name, RngType& type);
+	static uint64_t randomSeed(void);
+	static uint64_t subSeed(uint64_t seed, uint64_t index);
+
+private:
+	void _refill();
+
+	static const unsigned BUFFER_SIZE = 64;
+
+	//Member Variables
+	RngType _type;
+	Xoshiro256 _xoshiro;
+	Pcg64 _pcg;
+	Philox4x32 _philox;
+	unsigned _position;
+	uint32_t _buffer[BUFFER_SIZE];
+};
+#endif
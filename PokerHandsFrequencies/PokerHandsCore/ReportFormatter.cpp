@@ -0,0 +1,151 @@
+/*
+* Program: PokerHandFrequencies
+* Module: ReportFormatter.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Console report shared by the serial and parallel programs.
+*/
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <string>
+
+#include "HandStatistics.h"
+#include "ReportFormatter.h"
+
+using namespace std;
+
+//Const
+const int NAME_WIDTH = 15, FREQUENCY_WIDTH = 25, RELATIVE_WIDTH = 29;
+
+/*
+* Purpose: Get the name of a hand-type as it is shown in reports
+* Parameters: HandType
+* Returns: const char pointer
+*/
+const char* ReportFormatter::handTypeName(HandType type) {
+	static const char* names[NUM_HAND_TYPES] = {
+		"No Pair",
+		"One Pair",
+		"Two Pair",
+		"Three of a Kind",
+		"Straight",
+		"Flush",
+		"Full House",
+		"Four of a Kind",
+		"Straight Flush",
+		"Royal Flush"
+	};
+	return names[type];
+}
+
+/*
+* Purpose: Print the title of the report
+* Parameters: ostream, version shown in the title
+* Returns: None
+*/
+void ReportFormatter::printTitle(ostream& out, const char* version) {
+	out << "            Poker Hand Frequency Simulation [" << version << "]\n";
+	out << "================================================================================\n";
+}
+
+/*
+* Purpose: Print the title and column headings of the report
+* Parameters: ostream, version shown in the title
+* Returns: None
+*/
+void ReportFormatter::printHeader(ostream& out, const char* version) {
+	printTitle(out, version);
+	out << "        Hand Type                Frequency       Relative Frequency (%)         \n";
+	printRule(out);
+}
+
+/*
+* Purpose: Print the 95% Wilson interval of each hand-type's relative frequency and its half width
+*		   relative to the frequency, strongest hand first
+* Parameters: ostream, HandCounts
+* Returns: None
+*/
+void ReportFormatter::printIntervals(ostream& out, const HandCounts& counts) {
+	uint64_t handsGenerated = counts.total();
+	out << "        Hand Type       95% Low (%)      95% High (%)        +/- of Frequency (%)\n";
+	printRule(out);
+	out << fixed << setprecision(6);
+	for (int type = NUM_HAND_TYPES - 1; type >= 0; --type) {
+		double low, high;
+		HandStatistics::wilsonInterval(counts[(HandType)type], handsGenerated, low, high);
+		out << "  " << setw(NAME_WIDTH) << handTypeName((HandType)type)
+			<< setw(18) << 100.0 * low << setw(18) << 100.0 * high
+			<< setw(27) << 100.0 * HandStatistics::relativeHalfWidth(counts[(HandType)type], handsGenerated) << '\n';
+	}
+}
+
+/*
+* Purpose: Print the counts drawn from the multinomial next to the counts of the dealt hands and the
+*		   number of hands expected from the exact frequencies, strongest hand first
+* Parameters: ostream, HandCounts drawn from the multinomial, HandCounts of the dealt hands, Int cards per hand
+* Returns: None
+*/
+void ReportFormatter::printComparison(ostream& out, const HandCounts& sampled, const HandCounts& dealt, int cardsPerHand) {
+	uint64_t handsGenerated = dealt.total();
+	out << "        Hand Type         Multinomial               Dealt            Expected\n";
+	printRule(out);
+	out << fixed << setprecision(1);
+	for (int type = NUM_HAND_TYPES - 1; type >= 0; --type) {
+		out << "  " << setw(NAME_WIDTH) << handTypeName((HandType)type)
+			<< setw(20) << sampled[(HandType)type] << setw(20) << dealt[(HandType)type]
+			<< setw(20) << HandStatistics::exactFrequency((HandType)type, cardsPerHand) * handsGenerated << '\n';
+	}
+}
+
+/*
+* Purpose: Print the absolute and relative frequency of each hand-type, strongest hand first
+* Parameters: ostream, HandCounts
+* Returns: None
+*/
+void ReportFormatter::printCounts(ostream& out, const HandCounts& counts) {
+	uint64_t handsGenerated = counts.total();
+	out << fixed << setprecision(6);
+	for (int type = NUM_HAND_TYPES - 1; type >= 0; --type) {
+		double relative = (handsGenerated > 0) ? 100.0 * counts[(HandType)type] / handsGenerated : 0.0;
+		out << "  " << setw(NAME_WIDTH) << handTypeName((HandType)type)
+			<< setw(FREQUENCY_WIDTH) << counts[(HandType)type]
+			<< setw(RELATIVE_WIDTH) << relative << '\n';
+	}
+}
+
+/*
+* Purpose: Print the cycles and nanoseconds per hand spent in each phase and its share of the threads'
+*		   time. What is left of the threads' time (starting threads, checking the stopping rule, ...)
+*		   is shown as "Other". Prints nothing unless the program was built with PHF_PHASE_TIMING.
+* Parameters: ostream, PhaseTimes of every thread, uint64_t hands dealt, double seconds of every thread
+*			  added together
+* Returns: None
+*/
+void ReportFormatter::printPhases(ostream& out, const PhaseTimes& phases, uint64_t hands, double threadSeconds) {
+	if (!PhaseTimer::enabled() || hands == 0 || threadSeconds <= 0)
+		return;
+	double rate = PhaseTimer::cyclesPerSecond();
+	double threadCycles = threadSeconds * rate;
+	out << "            Phase     Cycles / hand         ns / hand          Time (%)\n";
+	printRule(out);
+	out << fixed << setprecision(2);
+	for (int phase = 0; phase <= NUM_PHASES; ++phase) {
+		double cycles = (phase < NUM_PHASES) ? (double)phases.cycles[phase] : max(0.0, threadCycles - phases.total());
+		if (phase == PHASE_MPI_WAIT && cycles == 0)
+			continue;
+		out << "  " << setw(NAME_WIDTH) << ((phase < NUM_PHASES) ? PhaseTimer::phaseName((Phase)phase) : "Other")
+			<< setw(18) << cycles / hands << setw(18) << 1e9 * cycles / rate / hands
+			<< setw(18) << 100.0 * cycles / threadCycles << '\n';
+	}
+}
+
+/*
+* Purpose: Print a horizontal rule across the report
+* Parameters: ostream
+* Returns: None
+*/
+void ReportFormatter::printRule(ostream& out) {
+	out << "--------------------------------------------------------------------------------\n";
+}
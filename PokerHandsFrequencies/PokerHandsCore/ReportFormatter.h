@@ -0,0 +1,45 @@
+#if !defined(__REPORTFORMATTER_H__)
+#define __REPORTFORMATTER_H__
+/*
+* Program: PokerHandFrequencies
+* Module: ReportFormatter.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Console report shared by the serial and parallel programs. Hand-type display
+*      names and column layout live here rather than in the counters.
+*/
+
+#include <iomanip>
+#include <ostream>
+
+#include "HandCounts.h"
+#include "HandEvaluator.h"
+#include "PhaseTimer.h"
+
+class ReportFormatter {
+public:
+
+	// Public static methods
+	static const char* handTypeName(HandType type);
+	static void printTitle(std::ostream& out, const char* version);
+	static void printHeader(std::ostream& out, const char* version);
+	static void printCounts(std::ostream& out, const HandCounts& counts);
+	static void printIntervals(std::ostream& out, const HandCounts& counts);
+	static void printComparison(std::ostream& out, const HandCounts& sampled, const HandCounts& dealt, int cardsPerHand);
+	static void printPhases(std::ostream& out, const PhaseTimes& phases, uint64_t hands, double threadSeconds);
+	static void printRule(std::ostream& out);
+
+	/*
+	* Purpose: Print one "label: value" line of the report summary with the colons lined up
+	* Parameters: ostream, label, value
+	* Returns: None
+	*/
+	template <typename Value>
+	static void printField(std::ostream& out, const char* label, const Value& value) {
+		out << std::setw(LABEL_WIDTH) << label << ": " << value << '\n';
+	}
+
+private:
+	static const int LABEL_WIDTH = 17;
+};
+#endif
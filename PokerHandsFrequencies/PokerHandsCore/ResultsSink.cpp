@@ -0,0 +1,282 @@
+/*
+* Program: PokerHandFrequencies
+* Module: ResultsSink.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Writes the snapshots of a run as it goes. See ResultsSink.h.
+*/
+
+#include <cctype>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#include "HandStatistics.h"
+#include "ReportFormatter.h"
+#include "ResultsSink.h"
+
+using namespace std;
+
+//Constructor
+ResultsSink::ResultsSink(){
+	_out = 0;
+	_format = FORMAT_JSON;
+	_numRanks = 0;
+	_sequence = 0;
+	_last.elapsed = 0;
+	_last.final = false;
+	_closing = false;
+}
+
+//Deconstructor
+ResultsSink::~ResultsSink(){
+	close();
+}
+
+/*
+* Purpose: Open the file the snapshots go to and start the thread that writes them. A csv file
+*		   gets its header line straight away.
+* Parameters: string path ("-" for the console), ResultFormat, Int number of ranks, double seconds
+*			  the run had already taken when it resumed (0 for a new run), string set to what went wrong
+* Returns: bool - false if the file can not be opened
+*/
+bool ResultsSink::open(const string& path, ResultFormat format, int numRanks, double startTime, string& error) {
+	close();
+	if (path == "-") {
+		_out = &cout;
+	}
+	else {
+		_file.open(path.c_str(), ios::trunc);
+		if (!_file) {
+			error = "can not open " + path;
+			return false;
+		}
+		_out = &_file;
+	}
+	_format = format;
+	_numRanks = numRanks;
+	_sequence = 0;
+	_last.elapsed = startTime;
+	_last.rankHands.assign(numRanks, 0);
+
+	if (_format == FORMAT_CSV) {
+		*_out << "snapshot,final,elapsed,hands,hands_per_sec,worst_half_width";
+		for (int type = NUM_HAND_TYPES - 1; type >= 0; --type)
+			*_out << ',' << _fieldName((HandType)type);
+		for (int rank = 0; rank < _numRanks; ++rank)
+			*_out << ",rank_" << rank << "_hands_per_sec";
+		*_out << endl;
+	}
+
+	_closing = false;
+	_writer = thread(&ResultsSink::_writeQueued, this);
+	return true;
+}
+
+/*
+* Purpose: Queue a snapshot for the sink's thread to write. Only copies the snapshot, so it can be
+*		   called from the loop that deals the hands.
+* Parameters: HandCounts of the whole run so far, double seconds since the run started, uint64_t hands
+*			  each rank has dealt in this segment, bool true for the last snapshot of the run
+* Returns: None
+*/
+void ResultsSink::publish(const HandCounts& counts, double elapsed, const vector<uint64_t>& rankHands, bool final) {
+	ResultSnapshot snapshot;
+	snapshot.counts = counts;
+	snapshot.elapsed = elapsed;
+	snapshot.rankHands = rankHands;
+	snapshot.final = final;
+	{
+		lock_guard<mutex> hold(_lock);
+		_queue.push_back(snapshot);
+	}
+	_queued.notify_one();
+}
+
+/*
+* Purpose: Write the snapshots still queued, stop the sink's thread and close the file
+* Parameters: None
+* Returns: None
+*/
+void ResultsSink::close() {
+	if (!_writer.joinable())
+		return;
+	{
+		lock_guard<mutex> hold(_lock);
+		_closing = true;
+	}
+	_queued.notify_one();
+	_writer.join();
+	if (_file.is_open())
+		_file.close();
+	_out = 0;
+}
+
+/*
+* Purpose: Check if the sink is taking snapshots
+* Parameters: None
+* Returns: bool
+*/
+bool ResultsSink::isOpen() const {
+	return _out != 0;
+}
+
+/*
+* Purpose: Get the name of a format as it is given on the command line
+* Parameters: ResultFormat
+* Returns: const char pointer
+*/
+const char* ResultsSink::formatName(ResultFormat format) {
+	static const char* names[NUM_RESULT_FORMATS] = { "json", "csv", "table" };
+	return names[format];
+}
+
+/*
+* Purpose: Look up a format by name
+* Parameters: string name, ResultFormat set when found
+* Returns: bool - true if the name is a format
+*/
+bool ResultsSink::parseFormat(const string& name, ResultFormat& format) {
+	for (int f = 0; f < NUM_RESULT_FORMATS; ++f) {
+		if (name == formatName((ResultFormat)f)) {
+			format = (ResultFormat)f;
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+* Purpose: The loop of the sink's thread. Takes every queued snapshot and writes it with the lock
+*		   released, until the sink is closed and the queue is empty.
+* Parameters: None
+* Returns: None
+*/
+void ResultsSink::_writeQueued() {
+	unique_lock<mutex> hold(_lock);
+	for (;;) {
+		_queued.wait(hold, [this] { return _closing || !_queue.empty(); });
+		if (_queue.empty())
+			return;
+		deque<ResultSnapshot> taken;
+		taken.swap(_queue);
+		hold.unlock();
+		for (size_t i = 0; i < taken.size(); ++i)
+			_write(taken[i]);
+		_out->flush();
+		hold.lock();
+	}
+}
+
+/*
+* Purpose: Work out the rates of a snapshot since the one before it and write it in the sink's format
+* Parameters: ResultSnapshot
+* Returns: None
+*/
+void ResultsSink::_write(const ResultSnapshot& snapshot) {
+	++_sequence;
+	double interval = snapshot.elapsed - _last.elapsed;
+	vector<double> rankRates(_numRanks, 0.0);
+	double rate = 0;
+	for (int rank = 0; rank < _numRanks && rank < (int)snapshot.rankHands.size(); ++rank) {
+		uint64_t dealt = snapshot.rankHands[rank] - _last.rankHands[rank];
+		rankRates[rank] = (interval > 0) ? dealt / interval : 0.0;
+		rate += rankRates[rank];
+	}
+
+	switch (_format) {
+	case FORMAT_CSV:
+		_writeCsv(snapshot, rate, rankRates);
+		break;
+	case FORMAT_TABLE:
+		_writeTable(snapshot, rate, rankRates);
+		break;
+	default:
+		_writeJson(snapshot, rate, rankRates);
+		break;
+	}
+	_last = snapshot;
+}
+
+/*
+* Purpose: Write a snapshot as one JSON object on one line. A half width that is not known yet (a
+*		   hand-type not seen) is null.
+* Parameters: ResultSnapshot, double hands per second, vector of each rank's hands per second
+* Returns: None
+*/
+void ResultsSink::_writeJson(const ResultSnapshot& snapshot, double rate, const vector<double>& rankRates) {
+	ostream& out = *_out;
+	double worst = HandStatistics::worstRelativeHalfWidth(snapshot.counts);
+	out << "{\"snapshot\":" << _sequence << ",\"final\":" << (snapshot.final ? "true" : "false")
+		<< fixed << setprecision(3) << ",\"elapsed\":" << snapshot.elapsed
+		<< ",\"hands\":" << snapshot.counts.total()
+		<< setprecision(0) << ",\"hands_per_sec\":" << rate << ",\"worst_half_width\":";
+	if (std::isfinite(worst))
+		out << setprecision(8) << worst;
+	else
+		out << "null";
+	out << ",\"counts\":{";
+	for (int type = NUM_HAND_TYPES - 1; type >= 0; --type)
+		out << ((type == NUM_HAND_TYPES - 1) ? "\"" : ",\"") << _fieldName((HandType)type) << "\":" << snapshot.counts[(HandType)type];
+	out << "},\"rank_hands_per_sec\":[" << setprecision(0);
+	for (int rank = 0; rank < _numRanks; ++rank)
+		out << ((rank == 0) ? "" : ",") << rankRates[rank];
+	out << "]}\n";
+}
+
+/*
+* Purpose: Write a snapshot as one line of the csv file, in the columns of its header. A half width
+*		   that is not known yet is left empty.
+* Parameters: ResultSnapshot, double hands per second, vector of each rank's hands per second
+* Returns: None
+*/
+void ResultsSink::_writeCsv(const ResultSnapshot& snapshot, double rate, const vector<double>& rankRates) {
+	ostream& out = *_out;
+	double worst = HandStatistics::worstRelativeHalfWidth(snapshot.counts);
+	out << _sequence << ',' << (snapshot.final ? 1 : 0) << ',' << fixed << setprecision(3) << snapshot.elapsed
+		<< ',' << snapshot.counts.total() << ',' << setprecision(0) << rate << ',';
+	if (std::isfinite(worst))
+		out << setprecision(8) << worst;
+	for (int type = NUM_HAND_TYPES - 1; type >= 0; --type)
+		out << ',' << snapshot.counts[(HandType)type];
+	out << setprecision(0);
+	for (int rank = 0; rank < _numRanks; ++rank)
+		out << ',' << rankRates[rank];
+	out << '\n';
+}
+
+/*
+* Purpose: Write a snapshot as the console table of the report, with the snapshot's fields under it
+* Parameters: ResultSnapshot, double hands per second, vector of each rank's hands per second
+* Returns: None
+*/
+void ResultsSink::_writeTable(const ResultSnapshot& snapshot, double rate, const vector<double>& rankRates) {
+	ostream& out = *_out;
+	out << "        Hand Type                Frequency       Relative Frequency (%)         \n";
+	ReportFormatter::printRule(out);
+	ReportFormatter::printCounts(out, snapshot.counts);
+	ReportFormatter::printRule(out);
+	ReportFormatter::printField(out, "Snapshot", snapshot.final ? to_string(_sequence) + " (final)" : to_string(_sequence));
+	out << fixed << setprecision(3);
+	ReportFormatter::printField(out, "Elapsed Time (s)", snapshot.elapsed);
+	ReportFormatter::printField(out, "Hands Generated", snapshot.counts.total());
+	out << setprecision(0);
+	ReportFormatter::printField(out, "Hands / sec", rate);
+	for (int rank = 0; rank < _numRanks && _numRanks > 1; ++rank)
+		ReportFormatter::printField(out, ("Rank " + to_string(rank) + " / sec").c_str(), rankRates[rank]);
+	out << setprecision(6);
+	ReportFormatter::printField(out, "Worst +/- (%)", 100.0 * HandStatistics::worstRelativeHalfWidth(snapshot.counts));
+	ReportFormatter::printRule(out);
+}
+
+/*
+* Purpose: Get the name of a hand-type's field in the json and csv formats, e.g. "four_of_a_kind"
+* Parameters: HandType
+* Returns: string
+*/
+string ResultsSink::_fieldName(HandType type) {
+	string name = ReportFormatter::handTypeName(type);
+	for (size_t i = 0; i < name.size(); ++i)
+		name[i] = (name[i] == ' ') ? '_' : (char)tolower((unsigned char)name[i]);
+	return name;
+}
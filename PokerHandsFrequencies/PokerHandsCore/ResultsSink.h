@@ -0,0 +1,95 @@
+#if !defined(__RESULTSSINK_H__)
+#define __RESULTSSINK_H__
+/*
+* Program: PokerHandFrequencies
+* Module: ResultsSink.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Snapshots of a run written as it goes to the --results file ("-" for the
+*      console), for dashboards to watch the counts converge. Each snapshot holds the counts so
+*      far, the worst 95% half width (relative to the frequency) of any hand-type, the hands per
+*      second since the last snapshot and the hands per second of each rank (process) over the
+*      same interval. Checked runs publish one every --snapshot-seconds and every run publishes
+*      a final one. A snapshot is written in one of these formats:
+*      - json:  one JSON object per line
+*      - csv:   a header line, then one line per snapshot
+*      - table: the console table of the report, with the snapshot's fields under it
+*      The simulation only copies a snapshot onto a queue; a thread of the sink formats and
+*      writes it, so a slow file system never holds up the dealing.
+*/
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "HandCounts.h"
+
+// How snapshots are written
+enum ResultFormat {
+	FORMAT_JSON,
+	FORMAT_CSV,
+	FORMAT_TABLE,
+	NUM_RESULT_FORMATS
+};
+
+// The state of a run at one point
+struct ResultSnapshot {
+
+	//Member Variables
+	HandCounts counts;
+	// Seconds since the run started
+	double elapsed;
+	// Hands each rank has dealt so far in this run segment
+	std::vector<uint64_t> rankHands;
+	bool final;
+};
+
+class ResultsSink {
+public:
+
+	//Constructor/Deconstructor
+	ResultsSink();
+	~ResultsSink();
+
+	//Public Methods
+	bool open(const std::string& path, ResultFormat format, int numRanks, double startTime, std::string& error);
+	void publish(const HandCounts& counts, double elapsed, const std::vector<uint64_t>& rankHands, bool final);
+	void close();
+	bool isOpen() const;
+
+	// Public static methods
+	static const char* formatName(ResultFormat format);
+	static bool parseFormat(const std::string& name, ResultFormat& format);
+
+private:
+	void _writeQueued();
+	void _write(const ResultSnapshot& snapshot);
+	void _writeJson(const ResultSnapshot& snapshot, double rate, const std::vector<double>& rankRates);
+	void _writeCsv(const ResultSnapshot& snapshot, double rate, const std::vector<double>& rankRates);
+	void _writeTable(const ResultSnapshot& snapshot, double rate, const std::vector<double>& rankRates);
+
+	// Private static method
+	static std::string _fieldName(HandType type);
+
+	//Member Variables
+	std::ofstream _file;
+	std::ostream* _out;
+	ResultFormat _format;
+	int _numRanks;
+	// Written by the sink's thread only
+	uint64_t _sequence;
+	ResultSnapshot _last;
+	// Snapshots waiting to be written, shared with the sink's thread
+	std::thread _writer;
+	std::mutex _lock;
+	std::condition_variable _queued;
+	std::deque<ResultSnapshot> _queue;
+	bool _closing;
+};
+#endif
@@ -0,0 +1,91 @@
+/*
+* Program: PokerHandFrequencies
+* Module: SevenCardEvaluator.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Finds the hand-type of the best 5 cards of a 7-card hand. See SevenCardEvaluator.h.
+*/
+
+#include "SevenCardEvaluator.h"
+
+//Globals
+bool SevenCardEvaluator::_tablesBuilt = false;
+unsigned char SevenCardEvaluator::_flushTable[1 << 13];
+unsigned char SevenCardEvaluator::_straightTable[1 << 13];
+unsigned char SevenCardEvaluator::_bitCount[1 << 13];
+unsigned short SevenCardEvaluator::_aceHigh[1 << 13];
+unsigned short SevenCardEvaluator::_straightTop[1 << 13];
+
+//Const
+// Rank bits of 10, J, Q, K and A
+const unsigned ROYAL_STRAIGHT = 0x1E01;
+
+//Constructor
+SevenCardEvaluator::SevenCardEvaluator(){
+	if (!_tablesBuilt)
+		_buildTables();
+}
+
+//Deconstructor
+SevenCardEvaluator::~SevenCardEvaluator(){
+}
+
+/*
+* Purpose: Check if a rank mask holds 5 ranks in a row, aces are low (A,2,3,4,5) or high (10,J,Q,K,A)
+* Parameters: Unsigned rank mask
+* Returns: bool
+*/
+static bool holdsStraight(unsigned ranks) {
+	if ((ranks & ROYAL_STRAIGHT) == ROYAL_STRAIGHT)
+		return true;
+	for (int low = 0; low + 5 <= 13; ++low) {
+		unsigned straight = 0x1Fu << low;
+		if ((ranks & straight) == straight)
+			return true;
+	}
+	return false;
+}
+
+/*
+* Purpose: Find the highest straight in a rank mask with the ace as its highest bit
+* Parameters: Unsigned ace high rank mask
+* Returns: Unsigned bit of the straight's top card, 0 if there is none
+*/
+static unsigned highestStraight(unsigned ranks) {
+	for (int top = 12; top >= 4; --top) {
+		unsigned straight = 0x1Fu << (top - 4);
+		if ((ranks & straight) == straight)
+			return 1u << top;
+	}
+	// A, 2, 3, 4, 5 is the lowest straight, its top card is the 5 (bit 3)
+	const unsigned wheel = (1u << 12) | 0xF;
+	return ((ranks & wheel) == wheel) ? (1u << 3) : 0;
+}
+
+/*
+* Purpose: Fill in the tables for every 13-bit rank mask
+* Parameters: void
+* Returns: None
+*/
+void SevenCardEvaluator::_buildTables(void) {
+	for (unsigned ranks = 0; ranks < (1 << 13); ++ranks) {
+		int count = 0;
+		for (unsigned bits = ranks; bits; bits &= bits - 1)
+			++count;
+		_bitCount[ranks] = (unsigned char)count;
+		_straightTable[ranks] = holdsStraight(ranks) ? 1 : 0;
+		_aceHigh[ranks] = (unsigned short)((ranks >> 1) | ((ranks & 1) << 12));
+		_straightTop[ranks] = (unsigned short)highestStraight(ranks);
+
+		if (count < 5)
+			_flushTable[ranks] = NO_PAIR;
+		else if ((ranks & ROYAL_STRAIGHT) == ROYAL_STRAIGHT)
+			_flushTable[ranks] = ROYAL_FLUSH;
+		else if (holdsStraight(ranks))
+			_flushTable[ranks] = STRAIGHT_FLUSH;
+		else
+			_flushTable[ranks] = FLUSH;
+	}
+
+	_tablesBuilt = true;
+}
@@ -0,0 +1,161 @@
+#if !defined(__SEVENCARDEVALUATOR_H__)
+#define __SEVENCARDEVALUATOR_H__
+/*
+* Program: PokerHandFrequencies
+* Module: SevenCardEvaluator.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Finds the hand-type of the best 5-card hand in a 7-card hand (Texas Hold'em,
+*      7-card stud) without trying its 21 5-card subsets. The hand is a card mask (see Card.h);
+*      tables indexed by a 13-bit rank mask say whether a suit holds a flush or straight flush
+*      and whether the ranks hold a straight, and pairs, triples and quadruples are the ranks
+*      held in at least 2, 3 or 4 suits, found with ANDs and ORs of the four suit masks. A
+*      flush rules out a full house or four of a kind in 7 cards, so a flush is final. Works
+*      for any hand of 5 to 7 cards.
+*      strength() also breaks ties between hands of the same type, for equity: the rank masks
+*      are reordered so the ace is the highest bit, and the strength is the hand-type, then
+*      the mask of the ranks that make the hand (the pair, the triple, the top of a straight),
+*      then the mask of the kickers. Comparing two masks of the same number of ranks as numbers
+*      compares their ranks highest first, so stronger hands always have larger strengths.
+*/
+
+#include <cstdint>
+
+#include "Card.h"
+#include "HandEvaluator.h"
+
+// Comparable strength of the best 5 cards of a hand, the hand-type is strength >> STRENGTH_TYPE_SHIFT
+typedef uint32_t HandStrength;
+static const int STRENGTH_TYPE_SHIFT = 26;
+
+class SevenCardEvaluator {
+public:
+
+	//Constructor/Deconstructor
+	SevenCardEvaluator();
+	~SevenCardEvaluator();
+
+	/*
+	* Purpose: Classify the best 5 cards of a hand of 5 to 7 distinct cards
+	* Parameters: HandMask of the cards
+	* Returns: The hand-type of the best 5-card hand
+	*/
+	inline HandType classify(HandMask hand) const {
+		unsigned s0 = suitRanks(hand, 0), s1 = suitRanks(hand, 1), s2 = suitRanks(hand, 2), s3 = suitRanks(hand, 3);
+
+		// At most one suit can hold 5 cards
+		unsigned flush = _flushTable[s0] | _flushTable[s1] | _flushTable[s2] | _flushTable[s3];
+		if (flush != NO_PAIR)
+			return (HandType)flush;
+
+		// The ranks held in at least 2, 3 and 4 suits
+		unsigned pairs = (s0 & s1) | (s2 & s3) | ((s0 | s1) & (s2 | s3));
+		unsigned trips = (s0 & s1 & (s2 | s3)) | (s2 & s3 & (s0 | s1));
+		unsigned quads = s0 & s1 & s2 & s3;
+		if (quads)
+			return FOUR_OF_A_KIND;
+		// A triple and another rank held at least twice
+		if (trips && _bitCount[pairs] >= 2)
+			return FULL_HOUSE;
+		if (_straightTable[s0 | s1 | s2 | s3])
+			return STRAIGHT;
+		if (trips)
+			return THREE_OF_A_KIND;
+		if (pairs)
+			return (_bitCount[pairs] >= 2) ? TWO_PAIR : ONE_PAIR;
+		return NO_PAIR;
+	}
+
+	/*
+	* Purpose: Get the strength of the best 5 cards of a hand of 5 to 7 distinct cards, so two hands
+	*		   can be compared. Works like classify() on rank masks with the ace as the highest rank.
+	* Parameters: HandMask of the cards
+	* Returns: HandStrength - larger is stronger, equal is a tie
+	*/
+	inline HandStrength strength(HandMask hand) const {
+		unsigned s0 = _aceHigh[suitRanks(hand, 0)], s1 = _aceHigh[suitRanks(hand, 1)];
+		unsigned s2 = _aceHigh[suitRanks(hand, 2)], s3 = _aceHigh[suitRanks(hand, 3)];
+
+		unsigned flushRanks = (_bitCount[s0] >= 5) ? s0 : (_bitCount[s1] >= 5) ? s1 : (_bitCount[s2] >= 5) ? s2 : (_bitCount[s3] >= 5) ? s3 : 0;
+		if (flushRanks) {
+			unsigned top = _straightTop[flushRanks];
+			if (top)
+				return _strength((top == ACE_HIGH) ? ROYAL_FLUSH : STRAIGHT_FLUSH, top, 0);
+			return _strength(FLUSH, _highest(flushRanks, 5), 0);
+		}
+
+		unsigned ranks = s0 | s1 | s2 | s3;
+		unsigned pairs = (s0 & s1) | (s2 & s3) | ((s0 | s1) & (s2 | s3));
+		unsigned trips = (s0 & s1 & (s2 | s3)) | (s2 & s3 & (s0 | s1));
+		unsigned quads = s0 & s1 & s2 & s3;
+		if (quads)
+			return _strength(FOUR_OF_A_KIND, quads, _highest(ranks & ~quads, 1));
+		if (trips) {
+			// The higher triple, and the best other rank held at least twice (maybe a second triple)
+			unsigned triple = _highest(trips, 1);
+			if (pairs & ~triple)
+				return _strength(FULL_HOUSE, triple, _highest(pairs & ~triple, 1));
+		}
+		unsigned top = _straightTop[ranks];
+		if (top)
+			return _strength(STRAIGHT, top, 0);
+		if (trips)
+			return _strength(THREE_OF_A_KIND, trips, _highest(ranks & ~trips, 2));
+		if (_bitCount[pairs] >= 2) {
+			unsigned twoPairs = _highest(pairs, 2);
+			return _strength(TWO_PAIR, twoPairs, _highest(ranks & ~twoPairs, 1));
+		}
+		if (pairs)
+			return _strength(ONE_PAIR, pairs, _highest(ranks & ~pairs, 3));
+		return _strength(NO_PAIR, _highest(ranks, 5), 0);
+	}
+
+	/*
+	* Purpose: Get the hand-type of a strength
+	* Parameters: HandStrength
+	* Returns: HandType
+	*/
+	static inline HandType strengthType(HandStrength strength) {
+		return (HandType)(strength >> STRENGTH_TYPE_SHIFT);
+	}
+
+private:
+	// The ace in a rank mask reordered by _aceHigh
+	static const unsigned ACE_HIGH = 1u << 12;
+
+	/*
+	* Purpose: Keep the highest ranks of a rank mask
+	* Parameters: Unsigned rank mask, Int number of ranks to keep
+	* Returns: unsigned
+	*/
+	static inline unsigned _highest(unsigned ranks, int keep) {
+		while (_bitCount[ranks] > keep)
+			ranks &= ranks - 1;
+		return ranks;
+	}
+
+	/*
+	* Purpose: Put a strength together from its hand-type and two rank masks
+	* Parameters: HandType, Unsigned ranks that make the hand, Unsigned kickers
+	* Returns: HandStrength
+	*/
+	static inline HandStrength _strength(HandType type, unsigned made, unsigned kickers) {
+		return ((HandStrength)type << STRENGTH_TYPE_SHIFT) | (made << 13) | kickers;
+	}
+
+	// Private static method
+	static void _buildTables(void);
+
+	// Shared lookup tables indexed by a 13-bit rank mask, built once by the first evaluator constructed
+	static bool _tablesBuilt;
+	// ROYAL_FLUSH, STRAIGHT_FLUSH or FLUSH for a suit holding 5 or more ranks, NO_PAIR otherwise
+	static unsigned char _flushTable[1 << 13];
+	// 1 when the ranks hold 5 in a row
+	static unsigned char _straightTable[1 << 13];
+	static unsigned char _bitCount[1 << 13];
+	// A rank mask with the ace moved from the lowest bit to the highest (2 is bit 0, ace bit 12)
+	static unsigned short _aceHigh[1 << 13];
+	// The top card of the highest straight in an ace high rank mask as its bit, 0 if none
+	static unsigned short _straightTop[1 << 13];
+};
+#endif
@@ -0,0 +1,312 @@
+/*
+* Program: PokerHandFrequencies
+* Module: SimulationOptions.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Command line options shared by the serial and parallel programs.
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "Checkpoint.h"
+#include "HandWorker.h"
+#include "SimulationOptions.h"
+
+using namespace std;
+
+//Const
+const int SELF_TEST_HANDS = 10000000;
+const double CHECKPOINT_SECONDS = 60;
+const double SNAPSHOT_SECONDS = 1;
+const double POLL_MICROSECONDS = 100;
+
+//Constructor
+SimulationOptions::SimulationOptions(){
+	seed = 0;
+	seedGiven = false;
+	generator = RNG_XOSHIRO256;
+	generatorGiven = false;
+	selfTest = false;
+	selfTestHands = SELF_TEST_HANDS;
+	exhaustive = false;
+	threads = 1;
+	tolerance = 0;
+	maxHands = 0;
+	maxSeconds = 0;
+	hands = 0;
+	reproducible = false;
+	multinomialHands = 0;
+	validate = false;
+	cardsPerHand = 5;
+	checkpointSeconds = CHECKPOINT_SECONDS;
+	resume = false;
+	resultFormat = FORMAT_JSON;
+	snapshotSeconds = SNAPSHOT_SECONDS;
+	pollMicroseconds = POLL_MICROSECONDS;
+	segment = 0;
+}
+
+//Deconstructor
+SimulationOptions::~SimulationOptions(){
+}
+
+/*
+* Purpose: Read the options from the command line. A seed is made for the run when none is given.
+* Parameters: Int argc, char pointer array argv
+* Returns: bool - false if the command line is not valid
+*/
+bool SimulationOptions::parse(int argc, char* argv[]) {
+	for (int i = 1; i < argc; ++i) {
+		string arg = argv[i];
+		bool hasValue = (i + 1 < argc);
+
+		if (arg == "--seed" && hasValue) {
+			if (!_parseCount(argv[++i], 0, ULLONG_MAX, seed)) {
+				cerr << "--seed needs a number from 0 to " << ULLONG_MAX << ", not " << argv[i] << endl;
+				return false;
+			}
+			seedGiven = true;
+		}
+		else if (arg == "--rng" && hasValue) {
+			if (!RandomStream::parseType(argv[++i], generator)) {
+				cerr << "Unknown generator: " << argv[i] << endl;
+				return false;
+			}
+			generatorGiven = true;
+		}
+		else if (arg == "--selftest") {
+			selfTest = true;
+			// The number of hands is optional
+			if (hasValue && argv[i + 1][0] != '-') {
+				uint64_t count;
+				if (!_parseCount(argv[++i], 1, INT_MAX, count)) {
+					cerr << "--selftest needs a number of hands, not " << argv[i] << endl;
+					return false;
+				}
+				selfTestHands = (int)count;
+			}
+		}
+		else if (arg == "--exhaustive") {
+			exhaustive = true;
+		}
+		else if (arg == "--threads" && hasValue) {
+			// At most one thread per stream of a checkpoint segment, see Checkpoint.h
+			uint64_t count;
+			if (!_parseCount(argv[++i], 0, SEGMENT_STREAMS, count)) {
+				cerr << "--threads needs a number of threads from 0 to " << SEGMENT_STREAMS
+					<< ", not " << argv[i] << endl;
+				return false;
+			}
+			threads = (int)count;
+			// 0 is every thread the machine can run
+			if (threads == 0)
+				threads = min(HandWorker::hardwareThreads(), (int)SEGMENT_STREAMS);
+		}
+		else if (arg == "--tolerance" && hasValue) {
+			tolerance = atof(argv[++i]);
+		}
+		else if (arg == "--max-hands" && hasValue) {
+			if (!_parseCount(argv[++i], 1, ULLONG_MAX, maxHands)) {
+				cerr << "--max-hands needs a number of hands, not " << argv[i] << endl;
+				return false;
+			}
+		}
+		else if (arg == "--max-seconds" && hasValue) {
+			maxSeconds = atof(argv[++i]);
+		}
+		else if (arg == "--hands" && hasValue) {
+			if (!_parseCount(argv[++i], 1, ULLONG_MAX, hands)) {
+				cerr << "--hands needs a number of hands, not " << argv[i] << endl;
+				return false;
+			}
+		}
+		else if (arg == "--reproducible") {
+			reproducible = true;
+		}
+		else if (arg == "--multinomial" && hasValue) {
+			if (!_parseCount(argv[++i], 1, ULLONG_MAX, multinomialHands)) {
+				cerr << "--multinomial needs a number of hands, not " << argv[i] << endl;
+				return false;
+			}
+		}
+		else if (arg == "--validate") {
+			validate = true;
+		}
+		else if (arg == "--cards" && hasValue) {
+			uint64_t count;
+			if (!_parseCount(argv[++i], 5, 7, count) || count == 6) {
+				cerr << "--cards must be 5 or 7, not " << argv[i] << endl;
+				return false;
+			}
+			cardsPerHand = (int)count;
+		}
+		else if (arg == "--equity" && hasValue) {
+			equityFile = argv[++i];
+		}
+		else if (arg == "--tables" && hasValue) {
+			tablesFile = argv[++i];
+		}
+		else if (arg == "--checkpoint" && hasValue) {
+			checkpointFile = argv[++i];
+		}
+		else if (arg == "--checkpoint-seconds" && hasValue) {
+			checkpointSeconds = atof(argv[++i]);
+			if (checkpointSeconds <= 0) {
+				cerr << "--checkpoint-seconds must be more than 0" << endl;
+				return false;
+			}
+		}
+		else if (arg == "--resume") {
+			resume = true;
+		}
+		else if (arg == "--results" && hasValue) {
+			resultsFile = argv[++i];
+		}
+		else if (arg == "--results-format" && hasValue) {
+			if (!ResultsSink::parseFormat(argv[++i], resultFormat)) {
+				cerr << "Unknown results format: " << argv[i] << endl;
+				return false;
+			}
+		}
+		else if (arg == "--snapshot-seconds" && hasValue) {
+			snapshotSeconds = atof(argv[++i]);
+			if (snapshotSeconds <= 0) {
+				cerr << "--snapshot-seconds must be more than 0" << endl;
+				return false;
+			}
+		}
+		else if (arg == "--poll-us" && hasValue) {
+			pollMicroseconds = atof(argv[++i]);
+			if (pollMicroseconds <= 0) {
+				cerr << "--poll-us must be more than 0" << endl;
+				return false;
+			}
+		}
+		else {
+			cerr << "Unknown option: " << arg << endl;
+			return false;
+		}
+	}
+
+	if (validate && multinomialHands == 0) {
+		cerr << "--validate checks a --multinomial run" << endl;
+		return false;
+	}
+
+	if (hands > 0 && (selfTest || exhaustive || multinomialHands > 0 || !equityFile.empty()
+		|| tolerance > 0 || maxHands > 0 || maxSeconds > 0)) {
+		cerr << "--hands can not be combined with --selftest, --exhaustive, --multinomial, --equity," << endl
+			<< "--tolerance, --max-hands or --max-seconds" << endl;
+		return false;
+	}
+
+	if (reproducible) {
+		if (hands == 0) {
+			cerr << "--reproducible deals the hands of a --hands run" << endl;
+			return false;
+		}
+		if (generatorGiven && generator != RNG_PHILOX) {
+			cerr << "--reproducible deals with philox, so --rng can only be philox" << endl;
+			return false;
+		}
+		// Every hand is dealt from its own Philox counter
+		generator = RNG_PHILOX;
+	}
+
+	if (!equityFile.empty() && (selfTest || multinomialHands > 0 || cardsPerHand != 5)) {
+		cerr << "--equity can not be combined with --selftest, --multinomial or --cards" << endl;
+		return false;
+	}
+
+	if (!checkpointFile.empty()) {
+		// Only a checked run deals for long enough to need a checkpoint
+		if (selfTest || exhaustive || multinomialHands > 0 || !equityFile.empty()
+			|| (tolerance <= 0 && maxHands == 0 && maxSeconds <= 0)) {
+			cerr << "--checkpoint is for runs with --tolerance, --max-hands or --max-seconds" << endl;
+			return false;
+		}
+	}
+	else if (resume) {
+		cerr << "--resume needs the --checkpoint file to resume from" << endl;
+		return false;
+	}
+
+	if (!resultsFile.empty() && (selfTest || !equityFile.empty())) {
+		cerr << "--results can not be combined with --selftest or --equity" << endl;
+		return false;
+	}
+
+	if (!seedGiven)
+		seed = RandomStream::randomSeed();
+	return true;
+}
+
+/*
+* Purpose: Read a count (of hands, threads, ...): digits alone, from minCount to maxCount. strtoull
+*		   on its own skips spaces, wraps "-5" round to a huge count and stops at the first non-digit.
+* Parameters: const char pointer to the text, uint64_t minCount and maxCount, uint64_t count set to
+*			  the number
+* Returns: bool - false if the text is not such a number
+*/
+bool SimulationOptions::_parseCount(const char* text, uint64_t minCount, uint64_t maxCount, uint64_t& count) {
+	if (!isdigit((unsigned char)text[0]))
+		return false;
+	char* end;
+	errno = 0;
+	unsigned long long value = strtoull(text, &end, 10);
+	if (*end != '\0' || errno == ERANGE || value < minCount || value > maxCount)
+		return false;
+	count = value;
+	return true;
+}
+
+/*
+* Purpose: Print the options to the console
+* Parameters: const char pointer to the program name
+* Returns: None
+*/
+void SimulationOptions::printUsage(const char* program) const {
+	cerr << "Usage: " << program << " [options]\n"
+		<< "  --seed N             seed for the random number generator (default: a new seed each run)\n"
+		<< "  --rng NAME           generator: xoshiro256 (default), pcg64 or philox\n"
+		<< "  --selftest [HANDS]   check the hand-type counts of HANDS hands (default " << SELF_TEST_HANDS << ")\n"
+		<< "                       against the exact frequencies\n"
+		<< "  --exhaustive         count every one of the 2,598,960 hands once and check the counts\n"
+		<< "                       are exact\n"
+		<< "  --threads N          deal hands on N threads, 0 for every hardware thread (default 1,\n"
+		<< "                       at most " << SEGMENT_STREAMS << ")\n"
+		<< "  --tolerance T        stop once the 95% interval of every hand type's frequency is within\n"
+		<< "                       T of the frequency (0.01 is 1%) instead of when every type is seen\n"
+		<< "  --max-hands N        stop after about N hands\n"
+		<< "  --max-seconds S      stop after about S seconds\n"
+		<< "  --hands N            deal exactly N hands; the parallel program hands them out in chunks\n"
+		<< "                       as the processes ask for them\n"
+		<< "  --reproducible       with --hands, deal hand i from the seed and i alone (philox), so the\n"
+		<< "                       counts are the same on any number of processes and threads\n"
+		<< "  --multinomial N      draw the hand-type counts of N hands from their exact multinomial\n"
+		<< "                       distribution instead of dealing the hands\n"
+		<< "  --validate           with --multinomial, also deal the N hands and check both sets of\n"
+		<< "                       counts agree with each other and with the exact frequencies\n"
+		<< "  --cards N            cards per hand: 5 (default) or 7, where the best 5 of the 7 count\n"
+		<< "  --equity FILE        Hold'em equity of each matchup in FILE, one per line, e.g.\n"
+		<< "                       \"AhKh vs QsQd | Jc Tc 2d\". Every board is dealt when there are few\n"
+		<< "                       left (or with --exhaustive), otherwise random boards until each\n"
+		<< "                       equity is within --tolerance (default 0.001) or --max-hands boards\n"
+		<< "  --tables FILE        map the tables PokerHandsTables wrote: --exhaustive counts 5-card\n"
+		<< "                       hands from them and --equity looks up a hand against \"random\"\n"
+		<< "  --checkpoint FILE    with --tolerance, --max-hands or --max-seconds, save the counts to\n"
+		<< "                       FILE at the end and every --checkpoint-seconds S (default " << CHECKPOINT_SECONDS << ")\n"
+		<< "  --resume             carry on from the --checkpoint file with new random number streams\n"
+		<< "  --results FILE       write snapshots of the counts and hands per second to FILE (- for\n"
+		<< "                       the console) every --snapshot-seconds S (default " << SNAPSHOT_SECONDS << ") of a run with\n"
+		<< "                       --tolerance, --max-hands or --max-seconds, and at the end of every run\n"
+		<< "  --results-format F   json (default, one object per line), csv or table\n"
+		<< "  --poll-us US         parallel only: deal about US microseconds of hands between checks\n"
+		<< "                       for the master's quit (default " << POLL_MICROSECONDS << ")\n";
+}
@@ -0,0 +1,64 @@
+#if !defined(__SIMULATIONOPTIONS_H__)
+#define __SIMULATIONOPTIONS_H__
+/*
+* Program: PokerHandFrequencies
+* Module: SimulationOptions.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Command line options shared by the serial and parallel programs.
+*/
+
+#include <cstdint>
+#include <string>
+
+#include "Random.h"
+#include "ResultsSink.h"
+
+class SimulationOptions {
+public:
+
+	//Constructor/Deconstructor
+	SimulationOptions();
+	~SimulationOptions();
+
+	//Public Methods
+	bool parse(int argc, char* argv[]);
+	void printUsage(const char* program) const;
+
+	//Member Variables
+	uint64_t seed;
+	bool seedGiven;
+	RngType generator;
+	bool generatorGiven;
+	bool selfTest;
+	int selfTestHands;
+	bool exhaustive;
+	int threads;
+	double tolerance;
+	uint64_t maxHands;
+	double maxSeconds;
+	// Hands a --hands run deals, exactly (0 when it is not one)
+	uint64_t hands;
+	// Deal hand i of a --hands run from (seed, i) alone, see HandRandom in Random.h
+	bool reproducible;
+	uint64_t multinomialHands;
+	bool validate;
+	int cardsPerHand;
+	std::string equityFile;
+	std::string tablesFile;
+	std::string checkpointFile;
+	double checkpointSeconds;
+	bool resume;
+	std::string resultsFile;
+	ResultFormat resultFormat;
+	double snapshotSeconds;
+	// Target time between the quit checks of a parallel process, see PollInterval.h
+	double pollMicroseconds;
+	// The segment of the run this is, 0 unless it resumes from a checkpoint (see Checkpoint.h)
+	uint32_t segment;
+
+private:
+	// Private static method
+	static bool _parseCount(const char* text, uint64_t minCount, uint64_t maxCount, uint64_t& count);
+};
+#endif
@@ -0,0 +1,75 @@
+/*
+* Program: PokerHandFrequencies
+* Module: StoppingRule.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: When a checked run stops. See StoppingRule.h.
+*/
+
+#include "HandStatistics.h"
+#include "StoppingRule.h"
+
+//Constructor
+StoppingRule::StoppingRule(const SimulationOptions& options){
+	_tolerance = options.tolerance;
+	_maxHands = options.maxHands;
+	_maxSeconds = options.maxSeconds;
+}
+
+//Deconstructor
+StoppingRule::~StoppingRule(){
+}
+
+/*
+* Purpose: Check if the run needs checking as it goes. Without a tolerance or a budget the run
+*		   stops at the hand that finds the last hand-type, which the programs do on their own.
+* Parameters: None
+* Returns: bool
+*/
+bool StoppingRule::isChecked() const {
+	return _tolerance > 0 || _maxHands > 0 || _maxSeconds > 0;
+}
+
+/*
+* Purpose: Check if the run stops at a tolerance
+* Parameters: None
+* Returns: bool
+*/
+bool StoppingRule::hasTolerance() const {
+	return _tolerance > 0;
+}
+
+/*
+* Purpose: Check if a checked run (see isChecked) with some counts so far should stop
+* Parameters: HandCounts of every thread (and process), double seconds since the run started
+* Returns: StopReason - STOP_NONE to keep going
+*/
+StopReason StoppingRule::check(const HandCounts& counts, double elapsed) const {
+	if (_tolerance > 0 && HandStatistics::worstRelativeHalfWidth(counts) <= _tolerance)
+		return STOP_TOLERANCE;
+	if (_maxHands > 0 && counts.total() >= _maxHands)
+		return STOP_HAND_BUDGET;
+	if (_maxSeconds > 0 && elapsed >= _maxSeconds)
+		return STOP_TIME_BUDGET;
+	return STOP_NONE;
+}
+
+/*
+* Purpose: Get a description of why a run stopped for the report
+* Parameters: StopReason
+* Returns: const char pointer
+*/
+const char* StoppingRule::reasonName(StopReason reason) {
+	switch (reason) {
+	case STOP_ALL_TYPES:
+		return "every hand type seen";
+	case STOP_TOLERANCE:
+		return "tolerance reached";
+	case STOP_HAND_BUDGET:
+		return "hand budget";
+	case STOP_TIME_BUDGET:
+		return "time budget";
+	default:
+		return "not stopped";
+	}
+}
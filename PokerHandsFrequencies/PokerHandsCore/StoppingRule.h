@@ -0,0 +1,51 @@
+#if !defined(__STOPPINGRULE_H__)
+#define __STOPPINGRULE_H__
+/*
+* Program: PokerHandFrequencies
+* Module: StoppingRule.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: When a checked run stops. With --tolerance it stops once the 95% interval of
+*      every hand-type's relative frequency is within the tolerance of the frequency, and
+*      --max-hands and --max-seconds stop it at a budget (early, when there is a tolerance).
+*      A run with neither is not checked: the programs stop it themselves at the hand that
+*      finds the last hand-type. The rule only looks at the counters, so it can be checked as
+*      often as every batch.
+*/
+
+#include <cstdint>
+
+#include "HandCounts.h"
+#include "SimulationOptions.h"
+
+// Why a run stopped
+enum StopReason {
+	STOP_NONE,
+	STOP_ALL_TYPES,
+	STOP_TOLERANCE,
+	STOP_HAND_BUDGET,
+	STOP_TIME_BUDGET
+};
+
+class StoppingRule {
+public:
+
+	//Constructor/Deconstructor
+	StoppingRule(const SimulationOptions& options);
+	~StoppingRule();
+
+	//Public Methods
+	bool isChecked() const;
+	bool hasTolerance() const;
+	StopReason check(const HandCounts& counts, double elapsed) const;
+
+	// Public static method
+	static const char* reasonName(StopReason reason);
+
+private:
+	//Member Variables
+	double _tolerance;
+	uint64_t _maxHands;
+	double _maxSeconds;
+};
+#endif
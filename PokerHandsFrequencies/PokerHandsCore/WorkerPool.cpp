@@ -0,0 +1,113 @@
+/*
+* Program: PokerHandFrequencies
+* Module: WorkerPool.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: The hand workers of one process, one per thread. See WorkerPool.h.
+*/
+
+#include "WorkerPool.h"
+
+using namespace std;
+
+//Constructor
+WorkerPool::WorkerPool(const SimulationOptions& options, int rank){
+	// Each thread gets its own worker with its own random number stream from the seed
+	for (int thread = 0; thread < options.threads; ++thread)
+		_workers.push_back(new HandWorker(options, rank, thread));
+}
+
+//Deconstructor
+WorkerPool::~WorkerPool(){
+	join();
+	for (size_t i = 0; i < _workers.size(); ++i)
+		delete _workers[i];
+}
+
+/*
+* Purpose: Run some work on every worker at once, worker 0 on this thread, and wait for all of them
+* Parameters: Work to run, called with a worker and its thread number
+* Returns: None
+*/
+void WorkerPool::run(const function<void(HandWorker&, int)>& work) {
+	start(work);
+	work(*_workers[0], 0);
+	join();
+}
+
+/*
+* Purpose: Start some work on every worker but worker 0, each on its own thread. The caller runs
+*		   worker 0 itself and then calls join().
+* Parameters: Work to run, called with a worker and its thread number
+* Returns: None
+*/
+void WorkerPool::start(const function<void(HandWorker&, int)>& work) {
+	for (int i = 1; i < (int)_workers.size(); ++i)
+		_threads.push_back(thread(work, ref(*_workers[i]), i));
+}
+
+/*
+* Purpose: Wait for the started threads to finish, then add the counts of all the workers together
+* Parameters: None
+* Returns: None
+*/
+void WorkerPool::join() {
+	for (size_t i = 0; i < _threads.size(); ++i)
+		_threads[i].join();
+	_threads.clear();
+
+	_counts.clear();
+	for (size_t i = 0; i < _workers.size(); ++i)
+		_counts.add(_workers[i]->counts());
+}
+
+/*
+* Purpose: Get the number of workers
+* Parameters: None
+* Returns: Int
+*/
+int WorkerPool::size() const {
+	return (int)_workers.size();
+}
+
+/*
+* Purpose: Get the worker of a thread
+* Parameters: Int thread number
+* Returns: HandWorker
+*/
+HandWorker& WorkerPool::worker(int thread) {
+	return *_workers[thread];
+}
+
+/*
+* Purpose: Get the counts of all the workers added together, as of the last join()
+* Parameters: None
+* Returns: HandCounts
+*/
+const HandCounts& WorkerPool::counts() const {
+	return _counts;
+}
+
+/*
+* Purpose: Get the counts of all the workers as of their last batch, while they are still dealing
+* Parameters: None
+* Returns: HandCounts
+*/
+HandCounts WorkerPool::publishedCounts() const {
+	HandCounts total;
+	for (size_t i = 0; i < _workers.size(); ++i)
+		_workers[i]->addPublishedCounts(total);
+	return total;
+}
+
+/*
+* Purpose: Get the cycles all the workers spent in each phase added together. Call it between runs.
+* Parameters: None
+* Returns: PhaseTimes
+*/
+PhaseTimes WorkerPool::phases() const {
+	PhaseTimes total;
+	for (size_t i = 0; i < _workers.size(); ++i)
+		total.add(_workers[i]->phases());
+	return total;
+}
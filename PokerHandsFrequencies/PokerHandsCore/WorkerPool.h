@@ -0,0 +1,44 @@
+#if !defined(__WORKERPOOL_H__)
+#define __WORKERPOOL_H__
+/*
+* Program: PokerHandFrequencies
+* Module: WorkerPool.h
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: The hand workers of one process, one per thread. Worker 0 always runs on the
+*      thread that owns the pool (the only one that talks to MPI in the parallel program),
+*      the others each get a thread of their own.
+*/
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "HandCounts.h"
+#include "HandWorker.h"
+#include "SimulationOptions.h"
+
+class WorkerPool {
+public:
+
+	//Constructor/Deconstructor
+	WorkerPool(const SimulationOptions& options, int rank);
+	~WorkerPool();
+
+	//Public Methods
+	void run(const std::function<void(HandWorker&, int)>& work);
+	void start(const std::function<void(HandWorker&, int)>& work);
+	void join();
+	int size() const;
+	HandWorker& worker(int thread);
+	const HandCounts& counts() const;
+	HandCounts publishedCounts() const;
+	PhaseTimes phases() const;
+
+private:
+	//Member Variables
+	std::vector<HandWorker*> _workers;
+	std::vector<std::thread> _threads;
+	HandCounts _counts;
+};
+#endif
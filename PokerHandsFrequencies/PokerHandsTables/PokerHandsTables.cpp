@@ -0,0 +1,107 @@
+/*
+* Program: PokerHandsTables
+* Module: PokerHandsTables.cpp
+* Author: Katherine Haldane & Jared Lerner
+* Date: October 16, 2026
+* Description: Builds the precomputed tables once and writes them to the file given with
+*      --tables, for the serial and parallel programs to map with --tables instead of working
+*      them out on every run: the strength of every 5-card hand and the equity of each of the
+*      169 starting hands against a random hand (see HandTables.h). The equities are dealt on
+*      --threads threads until each is within --tolerance (default 0.001). The file is then
+*      mapped back and checked: its checksum, the exact hand-type counts of the strength
+*      table and a few well known equities are printed. With --selftest an existing file is
+*      only checked.
+*/
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "../PokerHandsCore/HandStatistics.h"
+#include "../PokerHandsCore/HandTables.h"
+#include "../PokerHandsCore/PhaseTimer.h"
+#include "../PokerHandsCore/ReportFormatter.h"
+#include "../PokerHandsCore/SimulationOptions.h"
+#include "../PokerHandsCore/WorkerPool.h"
+
+using namespace std;
+
+//Const
+// Starting hands shown after the file is checked
+const char* const SHOWN_HANDS[] = { "AA", "AKs", "AKo", "T9s", "22", "72o" };
+
+/*
+* Purpose: Map a table file and check it: the header, the checksum and the hand-type counts of the
+*		   strength table. Prints the time to map it and the equities of a few starting hands.
+* Parameters: string path
+* Returns: bool - true if every check passes
+*/
+bool checkTables(const string& path) {
+	HandTables tables;
+	string error;
+	Stopwatch timer;
+	bool opened = tables.open(path, error);
+	double loadTime = timer.elapsed();
+	if (!opened) {
+		cerr << "Tables: " << error << endl;
+		return false;
+	}
+
+	timer.restart();
+	bool verified = tables.verify();
+	double verifyTime = timer.elapsed();
+	HandCounts counts;
+	tables.countRange(0, HandStatistics::totalHands(5), counts);
+	bool exact = HandStatistics::matchesExact(counts);
+
+	cout << "             Hand      Equity (%)         Win (%)         Tie (%)\n";
+	ReportFormatter::printRule(cout);
+	cout << fixed << setprecision(3);
+	for (size_t shown = 0; shown < sizeof(SHOWN_HANDS) / sizeof(SHOWN_HANDS[0]); ++shown) {
+		for (int hand = 0; hand < STARTING_HANDS; ++hand) {
+			if (HandTables::startingHandName(hand) != SHOWN_HANDS[shown])
+				continue;
+			const PreflopEquity& preflop = tables.preflop(hand);
+			cout << "  " << setw(15) << SHOWN_HANDS[shown] << setw(16) << 100.0 * preflop.equity
+				<< setw(16) << 100.0 * preflop.win << setw(16) << 100.0 * preflop.tie << '\n';
+		}
+	}
+	ReportFormatter::printRule(cout);
+	ReportFormatter::printField(cout, "Table Load (us)", 1e6 * loadTime);
+	ReportFormatter::printField(cout, "Checksum (ms)", 1e3 * verifyTime);
+	ReportFormatter::printField(cout, "Equity Seed", tables.seed());
+	ReportFormatter::printField(cout, "Checksum", verified ? "PASS" : "FAIL");
+	ReportFormatter::printField(cout, "Exact Counts", exact ? "PASS" : "FAIL");
+	return verified && exact;
+}
+
+int main(int argc, char* argv[])
+{
+	SimulationOptions options;
+	if (!options.parse(argc, argv) || options.tablesFile.empty()) {
+		cerr << "PokerHandsTables needs --tables FILE to write to\n";
+		options.printUsage(argv[0]);
+		return 1;
+	}
+
+	ReportFormatter::printTitle(cout, "Tables");
+	if (!options.selfTest) {
+		WorkerPool pool(options, 0);
+		string error;
+		Stopwatch timer;
+		if (!HandTables::generate(options.tablesFile, options, pool, error)) {
+			cerr << "Tables: " << error << endl;
+			return 1;
+		}
+		double elapsed = timer.elapsed();
+		cout << fixed << setprecision(3);
+		ReportFormatter::printField(cout, "Wrote", options.tablesFile);
+		ReportFormatter::printField(cout, "Elapsed Time (s)", elapsed);
+		ReportFormatter::printField(cout, "# of Threads", pool.size());
+		ReportFormatter::printRule(cout);
+	}
+
+	bool passed = checkTables(options.tablesFile);
+	ReportFormatter::printRule(cout);
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,40 @@
+# Program: PokerHandFrequencies
+# Module: CompareCounts.cmake
+# Author: Katherine Haldane & Jared Lerner
+# Date: October 16, 2026
+# Description: Test script that runs a program several ways and fails unless every run prints
+#      the same table of hand-type counts (the lines between the first two rules of the
+#      report). Each run is one command with its arguments separated by '|'.
+#
+#      cmake -DRUNS=2 -DRUN_1="prog|--threads|1" -DRUN_2="prog|--threads|3" -P CompareCounts.cmake
+
+foreach(run RANGE 1 ${RUNS})
+	string(REPLACE "|" ";" command "${RUN_${run}}")
+	execute_process(COMMAND ${command} RESULT_VARIABLE result OUTPUT_VARIABLE output)
+	if(NOT result EQUAL 0)
+		message(FATAL_ERROR "Run ${run} exited with ${result}: ${command}")
+	endif()
+
+	# The counts are the lines between the rule under the column titles and the next one
+	string(REPLACE "\n" ";" lines "${output}")
+	set(counts "")
+	set(rules 0)
+	foreach(line IN LISTS lines)
+		if(line MATCHES "^-+$")
+			math(EXPR rules "${rules} + 1")
+		elseif(rules EQUAL 1)
+			string(APPEND counts "${line}\n")
+		endif()
+	endforeach()
+	if(counts STREQUAL "")
+		message(FATAL_ERROR "Run ${run} printed no counts: ${command}")
+	endif()
+
+	if(run EQUAL 1)
+		set(expected "${counts}")
+	elseif(NOT counts STREQUAL expected)
+		message(FATAL_ERROR "Run ${run} counts differ from run 1: ${command}\n"
+			"Run 1:\n${expected}Run ${run}:\n${counts}")
+	endif()
+endforeach()
+message(STATUS "The counts of all ${RUNS} runs are the same")